@@ -60,7 +60,7 @@ bool borg_danger_wipe = false;
  * PFE reduces my fear of an area.
  *
  */
-static int borg_danger_physical(int i, bool full_damage)
+static int borg_danger_physical(int r_idx, bool full_damage)
 {
     int k, n = 0;
     int pfe = 0;
@@ -68,9 +68,7 @@ static int borg_danger_physical(int i, bool full_damage)
 
     int16_t ac                 = borg.trait[BI_ARMOR];
 
-    borg_kill *kill            = &borg_kills[i];
-
-    struct monster_race *r_ptr = &r_info[kill->r_idx];
+    struct monster_race *r_ptr = &r_info[r_idx];
 
     /* shields gives +50 to ac and deflects some missiles and balls*/
     if (borg.temp.shield)
@@ -84,9 +82,9 @@ static int borg_danger_physical(int i, bool full_damage)
     }
 
     /* Mega-Hack -- unknown monsters (or "player ghosts" */
-    if (kill->r_idx == 0)
+    if (r_idx == 0)
         return 1000;
-    if (kill->r_idx >= z_info->r_max - 1)
+    if (r_idx >= z_info->r_max - 1)
         return 1000;
 
     /* Analyze each physical attack */
@@ -543,6 +541,100 @@ static int borg_danger_physical(int i, bool full_damage)
     return n;
 }
 
+/*
+ * Traits read by borg_danger_physical()
+ */
+static const int borg_threat_traits[] = { BI_ARMOR, BI_CLEVEL, BI_CLASS,
+    BI_DAM_RED, BI_HLIFE, BI_MAXSP, BI_GOLD, BI_FOOD, BI_AFUEL, BI_RPOIS,
+    BI_RACID, BI_RELEC, BI_RFIRE, BI_RCOLD, BI_IACID, BI_IELEC, BI_IFIRE,
+    BI_ICOLD, BI_RBLIND, BI_RCONF, BI_RFEAR, BI_RDIS, BI_FRACT, BI_SSTR,
+    BI_SINT, BI_SWIS, BI_SDEX, BI_SCON, BI_CSTR, BI_CINT, BI_CWIS, BI_CDEX,
+    BI_CCON, BI_DEX_INDEX };
+
+/*
+ * Everything apart from the race that borg_danger_physical() depends on.
+ *
+ * Spell legality and the class casting stat only change when the borg
+ * notices its inventory or spells again, so the stamp stands in for them.
+ */
+struct borg_threat_sig {
+    uint32_t stamp;
+    int      trait[N_ELEMENTS(borg_threat_traits)];
+    bool     shield;
+    bool     prot_from_evil;
+    bool     res_acid;
+    bool     res_elec;
+    bool     res_fire;
+    bool     res_pois;
+    bool     attacking;
+    bool     fighting_unique;
+    bool     light_fuel;
+};
+
+/*
+ * Physical danger of each race, for partial and full damage
+ */
+struct borg_threat {
+    uint32_t gen;
+    int      danger;
+};
+
+static struct borg_threat    *borg_threats;
+static struct borg_threat_sig borg_threat_sig;
+static uint32_t               borg_threat_gen;
+static uint32_t               borg_threat_stamp;
+
+/*
+ * Forget the cached physical danger; call when the borg notices itself again
+ */
+void borg_threat_wipe(void)
+{
+    borg_threat_stamp++;
+}
+
+/*
+ * Physical danger of a race, reusing the last answer while nothing it
+ * depends on has changed.  Callers handle unknown races and player ghosts.
+ */
+static int borg_danger_physical_cached(int r_idx, bool full_damage)
+{
+    struct borg_threat_sig sig;
+    struct borg_threat    *threat;
+    int                    i;
+
+    memset(&sig, 0, sizeof(sig));
+    sig.stamp = borg_threat_stamp;
+    for (i = 0; i < (int)N_ELEMENTS(borg_threat_traits); i++)
+        sig.trait[i] = borg.trait[borg_threat_traits[i]];
+    sig.shield          = borg.temp.shield;
+    sig.prot_from_evil  = borg.temp.prot_from_evil;
+    sig.res_acid        = borg.temp.res_acid;
+    sig.res_elec        = borg.temp.res_elec;
+    sig.res_fire        = borg.temp.res_fire;
+    sig.res_pois        = borg.temp.res_pois;
+    sig.attacking       = borg_attacking;
+    sig.fighting_unique = borg_fighting_unique;
+    sig.light_fuel      = borg_items[INVEN_LIGHT].timeout
+                     && !of_has(borg_items[INVEN_LIGHT].flags, OF_NO_FUEL);
+
+    /* Start a new generation when anything changed */
+    if (memcmp(&sig, &borg_threat_sig, sizeof(sig))) {
+        memcpy(&borg_threat_sig, &sig, sizeof(sig));
+        if (!++borg_threat_gen) {
+            memset(borg_threats, 0,
+                2 * z_info->r_max * sizeof(struct borg_threat));
+            borg_threat_gen = 1;
+        }
+    }
+
+    threat = &borg_threats[r_idx * 2 + (full_damage ? 1 : 0)];
+    if (threat->gen != borg_threat_gen) {
+        threat->danger = borg_danger_physical(r_idx, full_damage);
+        threat->gen    = borg_threat_gen;
+    }
+    return threat->danger;
+}
+
 /*
  * Calculate base danger from a monster's spell attacks
  *
@@ -2396,7 +2488,7 @@ int borg_danger_one_kill(
     /** Danger from physical attacks **/
 
     /* Physical attacks */
-    v1 = borg_danger_physical(i, full_damage);
+    v1 = borg_danger_physical_cached(kill->r_idx, full_damage);
 
     /* If the Borg has been stuck on this panel for a long time, or if the
      * total turn count is very high, reduce the danger value. This helps
@@ -2866,4 +2958,18 @@ int borg_danger(int y, int x, int c, bool average, bool full_damage)
     return (p > 2000 ? 2000 : p);
 }
 
+void borg_init_danger(void)
+{
+    borg_threats = mem_zalloc(2 * z_info->r_max * sizeof(struct borg_threat));
+    memset(&borg_threat_sig, 0, sizeof(borg_threat_sig));
+    borg_threat_gen = 1;
+    borg_threat_stamp++;
+}
+
+void borg_free_danger(void)
+{
+    mem_free(borg_threats);
+    borg_threats = NULL;
+}
+
 #endif
@@ -87,5 +87,13 @@ extern int borg_danger_one_kill(
  */
 extern int borg_danger(int y, int x, int c, bool average, bool full_damage);
 
+/*
+ * Forget the cached physical danger of each race
+ */
+extern void borg_threat_wipe(void);
+
+extern void borg_init_danger(void);
+extern void borg_free_danger(void);
+
 #endif
 #endif
@@ -99,6 +99,23 @@ enum {
     BD_MAX
 };
 
+/*
+ * The averaged danger of standing still, as used by the elemental and PFE
+ * candidates.  Every candidate puts back whatever it pretends to have before
+ * returning, so this cannot change while borg_defend() scores them and is
+ * worked out once per scan instead of once per candidate.  -1 when unknown.
+ */
+static int borg_defend_avg_danger = -1;
+
+static int borg_defend_average_danger(void)
+{
+    if (borg_defend_avg_danger < 0)
+        borg_defend_avg_danger
+            = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+
+    return borg_defend_avg_danger;
+}
+
 /* Log the pathway and feature of the spell pathway
  * Useful for debugging beams and Tport Other spell
  */
@@ -419,7 +436,7 @@ static int borg_defend_aux_grim_purpose(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1 = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     /* pretend we are protected and look again */
     borg.trait[BI_RCONF] = true;
@@ -476,7 +493,7 @@ static int borg_defend_aux_resist_fecap(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1 = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     /* pretend we are protected and look again */
     save_fire          = borg.temp.res_fire;
@@ -580,7 +597,7 @@ static int borg_defend_aux_resist_f(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1 = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     /* pretend we are protected and look again */
     borg.temp.res_fire = true;
@@ -669,7 +686,7 @@ static int borg_defend_aux_resist_c(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1        = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     save_cold = borg.temp.res_cold;
     /* pretend we are protected and look again */
@@ -758,7 +775,7 @@ static int borg_defend_aux_resist_a(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1        = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     save_acid = borg.temp.res_acid;
     /* pretend we are protected and look again */
@@ -842,7 +859,7 @@ static int borg_defend_aux_resist_e(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1        = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     save_elec = borg.temp.res_elec;
     /* pretend we are protected and look again */
@@ -925,7 +942,7 @@ static int borg_defend_aux_resist_p(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1          = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     save_poison = borg.temp.res_pois;
     /* pretend we are protected and look again */
@@ -1013,7 +1030,7 @@ static int borg_defend_aux_prot_evil(int p1)
 
     /* elemental and PFE use the 'averaging' method for danger.  Redefine p1 as
      * such. */
-    p1 = borg_danger(borg.c.y, borg.c.x, 1, false, false);
+    p1 = borg_defend_average_danger();
 
     /* pretend we are protected and look again */
     borg.temp.prot_from_evil = true;
@@ -3579,6 +3596,7 @@ bool borg_defend(int p1)
     }
 
     /* Analyze the possible setup moves */
+    borg_defend_avg_danger = -1;
     for (g = 0; g < BD_MAX; g++) {
         /* Simulate */
         n = borg_calculate_defense_effectiveness(g, p1);
@@ -3601,7 +3619,8 @@ bool borg_defend(int p1)
     borg_note(format("# Performing defense type %d with value %d", b_g, b_n));
 
     /* Instantiate */
-    borg_simulate = false;
+    borg_simulate          = false;
+    borg_defend_avg_danger = -1;
 
     /* Instantiate */
     (void)borg_calculate_defense_effectiveness(b_g, p1);
@@ -29,6 +29,7 @@
 #include "../ui-prefs.h"
 
 #include "borg-cave.h"
+#include "borg-danger.h"
 #include "borg-flow-kill.h"
 #include "borg-flow-take.h"
 #include "borg-flow.h"
@@ -90,6 +91,7 @@ struct borg_setting borg_settings[] = {
     { "borg_allow_strange_opts", 'b', false},
     { "borg_autosave", 'b', false},
     { "borg_restore_ignore_settings", 'b', false},
+    { "borg_message_events", 'b', false},
     { 0, 0, 0 }};
 
 
@@ -408,8 +410,9 @@ void borg_reinit_options(void)
     /* The Borg uses the original keypress codes */
     option_set("rogue_like_commands", false);
 
-    /* No auto_more */
-    option_set("auto_more", false);
+    /* No auto_more, unless messages come from game events instead of the
+     * screen */
+    option_set("auto_more", borg_cfg[BORG_MESSAGE_EVENTS] ? true : false);
 
     /* We pick up items when we step on them */
     option_set("pickup_always", true);
@@ -582,6 +585,7 @@ void borg_init(void)
     borg_init_item_wear();
     borg_init_flow_take();
     borg_init_flow_kill();
+    borg_init_danger();
 
     borg_init_item();
     borg_init_store();
@@ -669,6 +673,7 @@ void borg_free(void)
     borg_free_item();
     borg_free_store();
 
+    borg_free_danger();
     borg_free_flow_kill();
     borg_free_flow_take();
     borg_free_item_wear();
@@ -23,6 +23,7 @@
 
 #include "../ui-term.h"
 
+#include "borg-messages.h"
 #include "borg-think.h"
 #include "borg.h"
 
@@ -489,6 +490,49 @@ void borg_dump_recent_keys(int num)
     }
 }
 
+/*
+ * Messages sent by the game since the borg last looked, oldest first.  Only
+ * collected when borg_message_events is set.
+ */
+static char **borg_message_queue     = NULL;
+static int    borg_message_queue_n   = 0;
+static int    borg_message_queue_max = 0;
+
+static void borg_message_event(
+    game_event_type unused, game_event_data *data, void *user)
+{
+    if (!borg_active || !borg_cfg[BORG_MESSAGE_EVENTS])
+        return;
+
+    /* Nothing the screen would have shown */
+    if (!data->message.msg || data->message.type == MSG_BELL)
+        return;
+
+    if (borg_message_queue_n == borg_message_queue_max) {
+        borg_message_queue_max
+            = borg_message_queue_max ? 2 * borg_message_queue_max : 32;
+        borg_message_queue     = mem_realloc(borg_message_queue,
+                borg_message_queue_max * sizeof(*borg_message_queue));
+    }
+    borg_message_queue[borg_message_queue_n++]
+        = string_make(data->message.msg);
+}
+
+/*
+ * Hand the collected messages to the parser, as reading them off the screen
+ * would have.
+ */
+void borg_parse_message_events(void)
+{
+    int i;
+
+    for (i = 0; i < borg_message_queue_n; i++) {
+        borg_parse(borg_message_queue[i]);
+        string_free(borg_message_queue[i]);
+    }
+    borg_message_queue_n = 0;
+}
+
 /*
  * The bell should never sound when the borg is running.  If it does,
  * log the keypress history and halt, if configured to do so.
@@ -515,12 +559,22 @@ void borg_init_io(void)
 
     /* When the bell goes off, log an error */
     event_add_handler(EVENT_BELL, borg_bell, NULL);
+
+    /* Collect messages if not reading them off the screen */
+    event_add_handler(EVENT_MESSAGE, borg_message_event, NULL);
 }
 
 void borg_free_io(void)
 {
     event_remove_handler(EVENT_BELL, borg_bell, NULL);
- 
+    event_remove_handler(EVENT_MESSAGE, borg_message_event, NULL);
+
+    while (borg_message_queue_n)
+        string_free(borg_message_queue[--borg_message_queue_n]);
+    mem_free(borg_message_queue);
+    borg_message_queue     = NULL;
+    borg_message_queue_max = 0;
+
     mem_free(borg_key_history);
     borg_key_history = NULL;
 
@@ -93,6 +93,8 @@ extern keycode_t borg_get_queued_direction(void);
  */
 extern char *borg_massage_special_chars(char *name);
 
+extern void borg_parse_message_events(void);
+
 extern void borg_init_io(void);
 extern void borg_free_io(void);
 
@@ -27,6 +27,7 @@
 
 #include "borg-cave.h"
 #include "borg-cave-view.h"
+#include "borg-danger.h"
 #include "borg-init.h"
 #include "borg-io.h"
 #include "borg-trait.h"
@@ -677,6 +678,9 @@ void borg_cheat_spells(void)
 {
     int i;
 
+    /* Spell legality feeds the cached danger */
+    borg_threat_wipe();
+
     /* Assume no books */
     for (i = 0; i < 9; i++)
         borg.book_idx[i] = -1;
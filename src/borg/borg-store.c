@@ -162,6 +162,8 @@ void borg_cheat_store(void)
             memset(&borg_shops[store_num].ware[i], 0, sizeof(borg_item));
         }
 
+        /* See the stock as it would be on entry */
+        store_catch_up(st_ptr);
         store_stock_list(st_ptr, list, z_info->store_inven_max);
 
         /* Check each existing object in this store */
@@ -28,6 +28,7 @@
 #include "../player-timed.h"
 #include "../player-util.h"
 
+#include "borg-danger.h"
 #include "borg-flow.h"
 #include "borg-flow-kill.h"
 #include "borg-item-activation.h"
@@ -2951,6 +2952,9 @@ void borg_notice(bool notice_swap)
         if (total_big_heal < 30 || (num_speed + borg.trait[BI_ASPEED]) < 15)
             borg.trait[BI_PREP_BIG_FIGHT] = true;
     }
+
+    /* Books, spells and light may have changed */
+    borg_threat_wipe();
 }
 
 /*
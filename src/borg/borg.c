@@ -321,6 +321,10 @@ static struct keypress internal_borg_inkey(int flush_first)
             return key;
     }
 
+    /* Parse what the game has said since the last key */
+    if (borg_cfg[BORG_MESSAGE_EVENTS])
+        borg_parse_message_events();
+
     /* Mega-Hack -- Handle death */
     if (player->is_dead) {
 #ifndef BABLOS
@@ -364,8 +368,9 @@ static struct keypress internal_borg_inkey(int flush_first)
         if (borg_cfg[BORG_VERBOSE])
             borg_note("# message with -more-");
 
-        /* Get the message */
-        if (0 == borg_what_text(0, 0, x - 7, &t_a, buffer)) {
+        /* Get the message, unless it came as an event */
+        if (!borg_cfg[BORG_MESSAGE_EVENTS]
+            && 0 == borg_what_text(0, 0, x - 7, &t_a, buffer)) {
             /* Parse it */
             borg_parse(buf);
         }
@@ -399,10 +404,10 @@ static struct keypress internal_borg_inkey(int flush_first)
     if (borg_prompt && inkey_flag) {
         if (borg_cfg[BORG_VERBOSE])
             borg_note("# parse normal message");
-        /* Get the message(s) */
+        /* Get the message(s), unless they came as events */
         buf = buffer;
-        if (0
-            == borg_what_text(
+        if (!borg_cfg[BORG_MESSAGE_EVENTS]
+            && 0 == borg_what_text(
                 0, 0, ((Term->wid - 1) / (tile_width)), &t_a, buffer)) {
             int k = strlen(buf);
 
@@ -78,6 +78,7 @@ enum {
     BORG_ALLOW_STRANGE_OPTS,
     BORG_AUTOSAVE,
     BORG_RESTORE_IGNORE_SETTINGS,
+    BORG_MESSAGE_EVENTS,
     BORG_MAX_SETTINGS
 };
 extern int *borg_cfg;
@@ -211,7 +211,7 @@ bool feat_is_smooth(int feat)
  */
 bool square_isfloor(struct chunk *c, struct loc grid)
 {
-	return feat_is_floor(square(c, grid)->feat);
+	return cplane_has(c, CPLANE_FLOOR, grid);
 }
 
 /**
@@ -663,7 +663,7 @@ bool square_is_monster_walkable(struct chunk *c, struct loc grid)
  */
 bool square_ispassable(struct chunk *c, struct loc grid) {
 	assert(square_in_bounds(c, grid));
-	return feat_is_passable(square(c, grid)->feat);
+	return cplane_has(c, CPLANE_PASSABLE, grid);
 }
 
 /**
@@ -671,7 +671,7 @@ bool square_ispassable(struct chunk *c, struct loc grid) {
  */
 bool square_isprojectable(struct chunk *c, struct loc grid) {
 	if (!square_in_bounds(c, grid)) return false;
-	return feat_is_projectable(square(c, grid)->feat);
+	return cplane_has(c, CPLANE_PROJECT, grid);
 }
 
 /**
@@ -737,7 +737,7 @@ bool square_isdamaging(struct chunk *c, struct loc grid) {
  */
 bool square_isnoflow(struct chunk *c, struct loc grid) {
 	assert(square_in_bounds(c, grid));
-	return feat_is_no_flow(square(c, grid)->feat);
+	return cplane_has(c, CPLANE_NO_FLOW, grid);
 }
 
 /**
@@ -1246,6 +1246,7 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
 
 	/* Make the change */
 	c->squares[grid.y][grid.x].feat = feat;
+	cave_update_planes(c, grid);
 
 	/* Light bright terrain */
 	if (feat_is_bright(feat)) {
@@ -1275,6 +1276,7 @@ static void square_set_known_feat(struct chunk *c, struct loc grid, int feat)
 {
 	if (c != cave) return;
 	player->cave->squares[grid.y][grid.x].feat = feat;
+	cave_update_planes(player->cave, grid);
 }
 
 /**
@@ -82,7 +82,7 @@ int distance(struct loc grid1, struct loc grid2)
  * determining which grids are illuminated by the player's torch, and which
  * grids and monsters can be "seen" by the player, etc).
  */
-bool los(struct chunk *c, struct loc grid1, struct loc grid2)
+static bool los_trace(struct chunk *c, struct loc grid1, struct loc grid2)
 {
 	/* Delta */
 	int dx, dy;
@@ -247,6 +247,61 @@ bool los(struct chunk *c, struct loc grid1, struct loc grid2)
 	return (true);
 }
 
+/**
+ * Remember sight lines to and from centre from now on.  Moving the centre
+ * forgets everything remembered about the old one.
+ */
+void cave_sight_centre(struct chunk *c, struct loc centre)
+{
+	size_t size = (size_t) c->height * c->width;
+
+	if (!c->sight_memo) {
+		c->sight_memo = mem_zalloc(size);
+	} else if (c->sight_stale || !loc_eq(c->sight_centre, centre)) {
+		memset(c->sight_memo, 0, size);
+	}
+	c->sight_centre = centre;
+	c->sight_stale = false;
+}
+
+/**
+ * Return the sight memo entry for grid if sight lines from centre are being
+ * remembered, or NULL if they are not.
+ *
+ * The entries depend only on the terrain, so a terrain change marks them
+ * all stale (see cave_update_planes()) and they are cleared here on the
+ * next use.
+ */
+uint8_t *cave_sight_memo(struct chunk *c, struct loc centre, struct loc grid)
+{
+	if (!c->sight_memo || !loc_eq(centre, c->sight_centre)) return NULL;
+	if (!square_in_bounds(c, grid)) return NULL;
+	if (c->sight_stale) {
+		memset(c->sight_memo, 0, (size_t) c->height * c->width);
+		c->sight_stale = false;
+	}
+	return &c->sight_memo[grid.y * c->width + grid.x];
+}
+
+/**
+ * Line of sight from grid1 to grid2; see los_trace().  Answers from the
+ * sight memo's centre are remembered.
+ */
+bool los(struct chunk *c, struct loc grid1, struct loc grid2)
+{
+	uint8_t *memo = cave_sight_memo(c, grid1, grid2);
+	bool result;
+
+	if (memo && (*memo & SIGHT_LOS_KNOWN)) {
+		return (*memo & SIGHT_LOS) != 0;
+	}
+	result = los_trace(c, grid1, grid2);
+	if (memo) {
+		*memo |= SIGHT_LOS_KNOWN | (result ? SIGHT_LOS : 0);
+	}
+	return result;
+}
+
 /**
  * The comments below are still predominantly true, and have been left
  * (slightly modified for accuracy) for historical and nostalgic reasons.
@@ -872,6 +927,9 @@ void update_view(struct chunk *c, struct player *p)
 {
 	int x, y;
 
+	/* Remember sight lines from the player while working out the view */
+	cave_sight_centre(c, p->grid);
+
 	/* Record the current view */
 	mark_wasseen(c);
 
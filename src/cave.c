@@ -342,13 +342,19 @@ const char *get_feat_code_name(int idx)
  * Allocate a new chunk of the world
  */
 struct chunk *cave_new(int height, int width) {
-	int y, x;
+	int y, x, i;
 
 	struct chunk *c = mem_zalloc(sizeof *c);
 	c->height = height;
 	c->width = width;
 	c->feat_count = mem_zalloc((FEAT_MAX + 1) * sizeof(int));
 
+	/* Allocate the bitplanes */
+	c->plane_stride = (c->width + CPLANE_BITS - 1) / CPLANE_BITS;
+	for (i = 0; i < CPLANE_MAX; i++) {
+		c->planes[i] = cave_bits_new(c);
+	}
+
 	c->squares = mem_zalloc(c->height * sizeof(struct square*));
 	c->noise.grids = mem_zalloc(c->height * sizeof(uint16_t*));
 	c->scent.grids = mem_zalloc(c->height * sizeof(uint16_t*));
@@ -361,6 +367,15 @@ struct chunk *cave_new(int height, int width) {
 		c->scent.grids[y] = mem_zalloc(c->width * sizeof(uint16_t));
 	}
 
+	/* Bitplanes start out matching the zeroed features */
+	if (f_info) {
+		for (y = 0; y < c->height; y++) {
+			for (x = 0; x < c->width; x++) {
+				cave_update_planes(c, loc(x, y));
+			}
+		}
+	}
+
 	c->objects = mem_zalloc(OBJECT_LIST_SIZE * sizeof(struct object*));
 	c->obj_max = OBJECT_LIST_SIZE - 1;
 
@@ -375,6 +390,119 @@ struct chunk *cave_new(int height, int width) {
 	return c;
 }
 
+/**
+ * Bring the bitplanes for a grid into line with its feature.  Anything which
+ * changes a feature without going through square_set_feat() must call this.
+ * \param c is the chunk to update
+ * \param grid is the grid whose feature was set
+ */
+void cave_update_planes(struct chunk *c, struct loc grid)
+{
+	static const int flags[CPLANE_MAX] = {
+		TF_PASSABLE, TF_PROJECT, TF_NO_FLOW, TF_FLOOR
+	};
+	const struct feature *f = &f_info[c->squares[grid.y][grid.x].feat];
+	int word = cplane_word(c, grid);
+	uint64_t bit = cplane_bit(grid);
+	int i;
+
+	for (i = 0; i < CPLANE_MAX; i++) {
+		if (tf_has(f->flags, flags[i])) {
+			c->planes[i][word] |= bit;
+		} else {
+			c->planes[i][word] &= ~bit;
+		}
+	}
+
+	/* Sight lines depend on the terrain */
+	c->sight_stale = true;
+}
+
+/**
+ * Allocate a cleared set of grids laid out like the chunk's bitplanes.
+ * Release it with mem_free().
+ */
+uint64_t *cave_bits_new(struct chunk *c)
+{
+	return mem_zalloc(c->height * c->plane_stride * sizeof(uint64_t));
+}
+
+/**
+ * Grow one word of a set of grids by one step along its row.
+ */
+static uint64_t cave_bits_row_grow(const uint64_t *row, int w, int stride)
+{
+	uint64_t grown = row[w] | (row[w] << 1) | (row[w] >> 1);
+
+	if (w > 0) grown |= row[w - 1] >> (CPLANE_BITS - 1);
+	if (w < stride - 1) grown |= row[w + 1] << (CPLANE_BITS - 1);
+	return grown;
+}
+
+/**
+ * Take one step of a breadth-first flood fill, a whole word of grids at a
+ * time.
+ * \param c is the chunk, which gives the layout of the sets
+ * \param frontier is the set of grids reached by the last step
+ * \param allowed is the set of grids the fill may enter
+ * \param visited is the set of grids already reached; the new grids are
+ * added to it
+ * \param next is set to the grids reached by this step
+ * \param diagonal is whether the fill moves diagonally as well
+ * \param ymin is the first row that may hold grids of frontier; at exit, it
+ * is the first row that may hold grids of next
+ * \param ymax is the last row that may hold grids of frontier; at exit, it
+ * is the last row that may hold grids of next
+ * \return whether any grids were reached
+ *
+ * Only the rows from *ymin to *ymax of frontier are read, and only the rows
+ * one beyond those are written in next, so two buffers can be swapped
+ * between steps without clearing them.
+ */
+bool cave_bits_step(struct chunk *c, const uint64_t *frontier,
+	const uint64_t *allowed, uint64_t *visited, uint64_t *next,
+	bool diagonal, int *ymin, int *ymax)
+{
+	int stride = c->plane_stride;
+	int y0 = MAX(*ymin - 1, 0), y1 = MIN(*ymax + 1, c->height - 1);
+	int new_min = c->height, new_max = -1;
+	int y, w;
+
+	for (y = y0; y <= y1; y++) {
+		const uint64_t *above = (y - 1 >= *ymin && y - 1 <= *ymax) ?
+			frontier + (y - 1) * stride : NULL;
+		const uint64_t *here = (y >= *ymin && y <= *ymax) ?
+			frontier + y * stride : NULL;
+		const uint64_t *below = (y + 1 >= *ymin && y + 1 <= *ymax) ?
+			frontier + (y + 1) * stride : NULL;
+		bool found = false;
+
+		for (w = 0; w < stride; w++) {
+			int i = y * stride + w;
+			uint64_t grown = here ? cave_bits_row_grow(here, w, stride) : 0;
+
+			if (diagonal) {
+				if (above) grown |= cave_bits_row_grow(above, w, stride);
+				if (below) grown |= cave_bits_row_grow(below, w, stride);
+			} else {
+				if (above) grown |= above[w];
+				if (below) grown |= below[w];
+			}
+			next[i] = grown & allowed[i] & ~visited[i];
+			visited[i] |= next[i];
+			if (next[i]) found = true;
+		}
+		if (found) {
+			new_min = MIN(new_min, y);
+			new_max = MAX(new_max, y);
+		}
+	}
+
+	*ymin = new_min;
+	*ymax = new_max;
+	return new_max >= 0;
+}
+
 /**
  * Free a linked list of cave connections.
  */
@@ -421,6 +549,10 @@ void cave_free(struct chunk *c) {
 	mem_free(c->noise.grids);
 	mem_free(c->scent.grids);
 
+	for (i = 0; i < CPLANE_MAX; i++) {
+		mem_free(c->planes[i]);
+	}
+	mem_free(c->sight_memo);
 	mem_free(c->feat_count);
 	mem_free(c->objects);
 	mem_free(c->monsters);
@@ -178,6 +178,33 @@ struct connector {
 	struct connector *next;
 };
 
+/**
+ * Terrain properties mirrored into per-chunk bitplanes, one bit per grid, so
+ * that hot predicates and flood fills can avoid looking up f_info
+ */
+enum cave_plane {
+	CPLANE_PASSABLE,	/* TF_PASSABLE */
+	CPLANE_PROJECT,		/* TF_PROJECT */
+	CPLANE_NO_FLOW,		/* TF_NO_FLOW */
+	CPLANE_FLOOR,		/* TF_FLOOR */
+	CPLANE_MAX
+};
+
+/**
+ * Bits per word of a bitplane, and the word and bit holding a grid
+ */
+#define CPLANE_BITS 64
+#define cplane_word(c, grid) \
+	((grid).y * (c)->plane_stride + (grid).x / CPLANE_BITS)
+#define cplane_bit(grid) \
+	(((uint64_t) 1) << ((grid).x % CPLANE_BITS))
+
+/**
+ * True if the bitplane has the bit for the grid set
+ */
+#define cplane_has(c, plane, grid) \
+	(((c)->planes[plane][cplane_word(c, grid)] & cplane_bit(grid)) != 0)
+
 struct chunk {
 	char *name;
 	int32_t turn;
@@ -195,6 +222,8 @@ struct chunk {
 	int *feat_count;
 
 	struct square **squares;
+	int plane_stride;	/* Words per row of each bitplane */
+	uint64_t *planes[CPLANE_MAX];
 	struct heatmap noise;
 	struct heatmap scent;
 	struct loc decoy;
@@ -211,6 +240,27 @@ struct chunk {
 	struct monster_group **monster_groups;
 
 	struct connector *join;
+
+	/* At least the number of traps with a timeout; see process_world() */
+	int timed_traps;
+
+	/* Remembered sight lines to and from one grid; see cave_sight_memo() */
+	uint8_t *sight_memo;
+	struct loc sight_centre;
+	bool sight_stale;
+};
+
+/**
+ * Bits of a grid's entry in the sight memo, each answer with a bit saying
+ * whether it is known yet
+ */
+enum {
+	SIGHT_LOS_KNOWN = 0x01,		/* los(centre, grid) */
+	SIGHT_LOS = 0x02,
+	SIGHT_FROM_KNOWN = 0x04,	/* projectable(centre, grid, PROJECT_NONE) */
+	SIGHT_FROM = 0x08,
+	SIGHT_TO_KNOWN = 0x10,		/* projectable(grid, centre, PROJECT_SHORT) */
+	SIGHT_TO = 0x20
 };
 
 /*** Feature Indexes (see "lib/gamedata/terrain.txt") ***/
@@ -229,6 +279,8 @@ extern uint16_t chunk_list_max;
 
 /* cave-view.c */
 int distance(struct loc grid1, struct loc grid2);
+void cave_sight_centre(struct chunk *c, struct loc centre);
+uint8_t *cave_sight_memo(struct chunk *c, struct loc centre, struct loc grid);
 bool los(struct chunk *c, struct loc grid1, struct loc grid2);
 void update_view(struct chunk *c, struct player *p);
 bool no_light(const struct player *p);
@@ -433,6 +485,11 @@ const char *get_feat_code_name(int idx);
 struct chunk *cave_new(int height, int width);
 void cave_connectors_free(struct connector *join);
 void cave_free(struct chunk *c);
+void cave_update_planes(struct chunk *c, struct loc grid);
+uint64_t *cave_bits_new(struct chunk *c);
+bool cave_bits_step(struct chunk *c, const uint64_t *frontier,
+	const uint64_t *allowed, uint64_t *visited, uint64_t *next,
+	bool diagonal, int *ymin, int *ymax);
 void list_object(struct chunk *c, struct object *obj);
 void delist_object(struct chunk *c, struct object *obj);
 void object_lists_check_integrity(struct chunk *c, struct chunk *c_k);
@@ -0,0 +1,6 @@
+macro(configure_bench_frontend _NAME_TARGET)
+
+    target_compile_definitions(${_NAME_TARGET} PRIVATE -D USE_BENCH)
+    message(STATUS "Support for benchmark front end - Ready")
+
+endmacro()
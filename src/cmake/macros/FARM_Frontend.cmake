@@ -0,0 +1,10 @@
+macro(configure_farm_frontend _NAME_TARGET)
+
+    if(SUPPORT_BORG)
+        target_compile_definitions(${_NAME_TARGET} PRIVATE -D USE_FARM -D ALLOW_BORG)
+        message(STATUS "Support for borg farm front end - Ready")
+    else()
+        message(WARNING "Disabling borg farm front end because the Borg is disabled")
+    endif()
+
+endmacro()
@@ -0,0 +1,16 @@
+macro(configure_spectator _NAME_TARGET _ONLY_LINK)
+    set(PREVIOUS_INVOCATION ${CONFIGURE_SPECTATOR_INVOKED_PREVIOUSLY})
+    if(NOT ${_ONLY_LINK})
+        target_compile_definitions(${_NAME_TARGET} PRIVATE -D USE_SPECTATOR)
+    endif()
+    # Older C libraries keep shm_open() in librt.
+    find_library(RT_LIBRARY rt)
+    if(RT_LIBRARY)
+        target_link_libraries(${_NAME_TARGET} PRIVATE ${RT_LIBRARY})
+    endif()
+    if(NOT PREVIOUS_INVOCATION)
+        message(STATUS "Support for spectators - Ready")
+    endif()
+    set(CONFIGURE_SPECTATOR_INVOKED_PREVIOUSLY YES CACHE
+        INTERNAL "Mark if CONFIGURE_SPECTATOR called successfully" FORCE)
+endmacro()
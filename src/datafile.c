@@ -391,8 +391,8 @@ errr grab_index_and_int(int *value, int *index, const char **value_type,
 		my_strcpy(value_string, prefix, strlen(prefix) + 1);
 	}
 
-	free(value_string);
-	free(value_name);
+	string_free(value_string);
+	string_free(value_name);
 	if (value_type[i])
 		*index = i;
 
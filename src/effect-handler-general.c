@@ -201,6 +201,7 @@ static bool uncurse_object(struct object *obj, int strength, char *dice_string)
 			msgt(MSG_CURSED, "The spell fails; your %s is now fragile.", o_name);
 			of_on(obj->flags, OF_FRAGILE);
 			player_learn_flag(player, OF_FRAGILE);
+			player_know_object(player, obj);
 		} else if (one_in_(4)) {
 			/* Failure - unlucky fragile object is destroyed */
 			struct object *destroyed;
@@ -464,8 +465,8 @@ static void brand_object(struct object *obj, const char *name)
 		ego_apply_magic(obj, 0);
 		player_know_object(player, obj);
 
-		/* Update the gear */
-		player->upkeep->update |= (PU_INVEN);
+		/* Update the gear and any bonuses it grants */
+		player->upkeep->update |= (PU_BONUS | PU_INVEN);
 
 		/* Combine the pack (later) */
 		player->upkeep->notice |= (PN_COMBINE);
@@ -2513,10 +2514,7 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 	int pick;
 	struct loc grid;
 
-	struct jumps {
-		struct loc grid;
-		struct jumps *next;
-	} *spots = NULL;
+	struct loc *spots;
 	int num_spots = 0;
 	int current_score = 2 * MAX(z_info->dungeon_wid, z_info->dungeon_hgt);
 	bool only_vault_grids_possible = true;
@@ -2581,16 +2579,23 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 	}
 
 	/* Make a list of the best grids, scoring by how good an approximation
-	 * the distance from the start is to the distance we want */
+	 * the distance from the start is to the distance we want.  Every grid
+	 * fits in the list, so it is allocated once rather than per spot. */
+	spots = mem_alloc((cave->height - 2) * (cave->width - 2)
+		* sizeof(*spots));
 	for (grid.y = 1; grid.y < cave->height - 1; grid.y++) {
 		for (grid.x = 1; grid.x < cave->width - 1; grid.x++) {
 			int d = distance(grid, start);
 			int score = ABS(d - dis);
-			struct jumps *new;
 
 			/* Must move */
 			if (d == 0) continue;
 
+			/* Once a non-vault grid is in, worse scores never are */
+			if (!only_vault_grids_possible && score > current_score) {
+				continue;
+			}
+
 			if (!has_teleport_destination_prereqs(cave, grid,
 					is_player)) continue;
 
@@ -2611,25 +2616,12 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 			/* Do we have better spots already? */
 			if (score > current_score) continue;
 
-			/* Make a new spot */
-			new = mem_zalloc(sizeof(struct jumps));
-			new->grid = grid;
-
 			/* If improving start a new list, otherwise extend the old one */
 			if (score < current_score) {
 				current_score = score;
-				while (spots) {
-					struct jumps *next = spots->next;
-					mem_free(spots);
-					spots = next;
-				}
-				spots = new;
-				num_spots = 1;
-			} else {
-				new->next = spots;
-				spots = new;
-				num_spots++;
+				num_spots = 0;
 			}
+			spots[num_spots++] = grid;
 		}
 	}
 
@@ -2650,30 +2642,27 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 					true);
 			}
 		}
+		mem_free(spots);
 		return true;
 	}
 
-	/* Pick a spot */
+	/* Pick a spot, counting back from the last one found */
 	pick = randint0(num_spots);
-	while (pick) {
-		struct jumps *next = spots->next;
-		mem_free(spots);
-		spots = next;
-		pick--;
-	}
+	grid = spots[num_spots - 1 - pick];
+	mem_free(spots);
 
 	/* Sound */
 	sound(is_player ? MSG_TELEPORT : MSG_TPOTHER);
 
 	/* Move player or monster */
-	monster_swap(start, spots->grid);
+	monster_swap(start, grid);
 	if (is_player) {
 		player_handle_post_move(player, true,
 			context->origin.what == SRC_MONSTER);
 	}
 
 	/* Clear any projection marker to prevent double processing */
-	sqinfo_off(square(cave, spots->grid)->info, SQUARE_PROJECT);
+	sqinfo_off(square(cave, grid)->info, SQUARE_PROJECT);
 
 	/* Clear monster target if it's no longer visible */
 	if (!target_able(target_get_monster())) {
@@ -2683,12 +2672,6 @@ bool effect_handler_TELEPORT(effect_handler_context_t *context)
 	/* Lots of updates after monster_swap */
 	handle_stuff(player);
 
-	while (spots) {
-		struct jumps *next = spots->next;
-		mem_free(spots);
-		spots = next;
-	}
-
 	return true;
 }
 
@@ -3141,6 +3124,9 @@ bool effect_handler_CURSE_ARMOR(effect_handler_context_t *context)
 			num--;
 		}
 
+		/* Show the new bonuses and any curses already known */
+		player_know_object(player, obj);
+
 		/* Account for a weight change, if any */
 		player->upkeep->total_weight +=
 			(obj->number * object_weight_one(obj)) - old_weight;
@@ -3206,6 +3192,9 @@ bool effect_handler_CURSE_WEAPON(effect_handler_context_t *context)
 			num--;
 		}
 
+		/* Show the new bonuses and any curses already known */
+		player_know_object(player, obj);
+
 		/* Account for a weight change, if any */
 		player->upkeep->total_weight +=
 			(obj->number * object_weight_one(obj)) - old_weight;
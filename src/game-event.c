@@ -19,6 +19,7 @@
 #include <assert.h>
 #include "game-event.h"
 #include "object.h"
+#include "z-util.h"
 #include "z-virt.h"
 
 struct event_handler_entry
@@ -40,7 +41,9 @@ static void game_event_dispatch(game_event_type type, game_event_data *data)
 	while (this)
 	{
 		/* Call the handler with the relevant data */
+		if (probe_aux) (*probe_aux)(PROBE_EVENT, type, false);
 		this->fn(type, data, this->user);
+		if (probe_aux) (*probe_aux)(PROBE_EVENT, type, true);
 		this = this->next;
 	}
 }
@@ -37,7 +37,6 @@
 #include "source.h"
 #include "target.h"
 #include "trap.h"
-#include "z-queue.h"
 
 uint16_t daycount = 0;
 uint32_t seed_randart;		/* Consistent random artifacts */
@@ -386,61 +385,72 @@ static void decrease_timeouts(void)
  */
 static void make_noise(struct player *p)
 {
-	struct loc next = p->grid;
-	int y, x, d;
+	int y, x, w;
 	int noise = 0;
 	int noise_increment = p->timed[TMD_COVERTRACKS] ? 4 : 1;
-    struct queue *queue = q_new(cave->height * cave->width);
+	int stride = cave->plane_stride;
+	int ymin = p->grid.y, ymax = p->grid.y;
+	uint64_t *flow = cave_bits_new(cave);
+	uint64_t *visited = cave_bits_new(cave);
+	uint64_t *frontier = cave_bits_new(cave);
+	uint64_t *next = cave_bits_new(cave);
+
+	/*
+	 * Set all the grids to silence, and note where sound can travel; grids
+	 * which already have noise are treated as reached
+	 */
+	for (y = 0; y < cave->height; y++) {
+		for (x = 0; x < cave->width; x++) {
+			struct loc grid = loc(x, y);
 
-	/* Set all the grids to silence */
-	for (y = 1; y < cave->height - 1; y++) {
-		for (x = 1; x < cave->width - 1; x++) {
-			cave->noise.grids[y][x] = 0;
+			if (y > 0 && y < cave->height - 1 && x > 0
+					&& x < cave->width - 1) {
+				cave->noise.grids[y][x] = 0;
+			}
+			if (cave->noise.grids[y][x] != 0) {
+				visited[cplane_word(cave, grid)] |= cplane_bit(grid);
+			}
+		}
+		for (w = 0; w < stride; w++) {
+			flow[y * stride + w] =
+				~cave->planes[CPLANE_NO_FLOW][y * stride + w];
+		}
+		if (cave->width % CPLANE_BITS) {
+			flow[(y + 1) * stride - 1] &=
+				(((uint64_t) 1) << (cave->width % CPLANE_BITS)) - 1;
 		}
 	}
 
 	/* Player makes noise */
-	cave->noise.grids[next.y][next.x] = noise;
-	q_push_int(queue, grid_to_i(next, cave->width));
-	noise += noise_increment;
-
-	/* Propagate noise */
-	while (q_len(queue) > 0) {
-		/* Get the next grid */
-		i_to_grid(q_pop_int(queue), cave->width, &next);
-
-		/* If we've reached the current noise level, put it back and step */
-		if (cave->noise.grids[next.y][next.x] == noise) {
-			q_push_int(queue, grid_to_i(next, cave->width));
-			noise += noise_increment;
-			continue;
-		}
+	cave->noise.grids[p->grid.y][p->grid.x] = noise;
+	frontier[cplane_word(cave, p->grid)] |= cplane_bit(p->grid);
+	visited[cplane_word(cave, p->grid)] |= cplane_bit(p->grid);
 
-		/* Assign noise to the children and enqueue them */
-		for (d = 0; d < 8; d++)	{
-			/* Child location */
-			struct loc grid = loc_sum(next, ddgrid_ddd[d]);
+	/* Propagate noise a whole step at a time */
+	while (cave_bits_step(cave, frontier, flow, visited, next, true, &ymin,
+			&ymax)) {
+		uint64_t *swap = frontier;
 
-			if (!square_in_bounds(cave, grid)) continue;
+		noise += noise_increment;
 
-			/* Ignore features that don't transmit sound */
-			if (square_isnoflow(cave, grid)) continue;
+		/* Save the noise for every grid reached by this step */
+		for (y = ymin; y <= ymax; y++) {
+			for (w = 0; w < stride; w++) {
+				uint64_t bits = next[y * stride + w];
 
-			/* Skip grids that already have noise */
-			if (cave->noise.grids[grid.y][grid.x] != 0) continue;
-
-			/* Skip the player grid */
-			if (loc_eq(p->grid, grid)) continue;
-
-			/* Save the noise */
-			cave->noise.grids[grid.y][grid.x] = noise;
-
-			/* Enqueue that entry */
-			q_push_int(queue, grid_to_i(grid, cave->width));
+				for (x = w * CPLANE_BITS; bits; x++, bits >>= 1) {
+					if (bits & 1) cave->noise.grids[y][x] = noise;
+				}
+			}
 		}
+		frontier = next;
+		next = swap;
 	}
 
-	q_free(queue);
+	mem_free(next);
+	mem_free(frontier);
+	mem_free(visited);
+	mem_free(flow);
 }
 
 /**
@@ -755,26 +765,33 @@ void process_world(struct chunk *c)
 	if (!(turn % 100))
 		equip_learn_after_time(player);
 
-	/* Decrease trap timeouts */
-	for (y = 0; y < c->height; y++) {
-		for (x = 0; x < c->width; x++) {
-			struct loc grid = loc(x, y);
-			struct trap *trap = square(c, grid)->trap;
-			bool changed = false;
-			while (trap) {
-				if (trap->timeout) {
-					trap->timeout--;
-					if (!trap->timeout) {
-						changed = true;
+	/* Decrease trap timeouts; only look if some trap may have one */
+	if (c->timed_traps) {
+		int timed = 0;
+
+		for (y = 0; y < c->height; y++) {
+			for (x = 0; x < c->width; x++) {
+				struct loc grid = loc(x, y);
+				struct trap *trap = square(c, grid)->trap;
+				bool changed = false;
+				while (trap) {
+					if (trap->timeout) {
+						trap->timeout--;
+						if (!trap->timeout) {
+							changed = true;
+						} else {
+							timed++;
+						}
 					}
+					trap = trap->next;
+				}
+				if (changed && square_isseen(c, grid)) {
+					square_memorize_traps(c, grid);
+					square_light_spot(c, grid);
 				}
-				trap = trap->next;
-			}
-			if (changed && square_isseen(c, grid)) {
-				square_memorize_traps(c, grid);
-				square_light_spot(c, grid);
 			}
 		}
+		c->timed_traps = timed;
 	}
 
 
@@ -996,6 +1013,43 @@ void process_player(void)
 	notice_stuff(player);
 }
 
+/**
+ * Pass over the game turns from now on in which nothing but energy and the
+ * sleep of dozing monsters would change, exactly as the main game loop would
+ * have done them one by one.
+ *
+ * A turn is quiet when it does not process the world, the player ends it
+ * still short of a move, and no monster would act in it; in such a turn the
+ * per-turn monster updates and refreshes find nothing to do.  See
+ * skip_monster_turns() for which monster turns count as quiet.
+ */
+static void skip_quiet_turns(void)
+{
+	int gain = turn_energy(player->state.speed);
+	int skip;
+
+	/* The main loop would go straight on to leaving the level */
+	if (player->is_dead || !player->upkeep->playing
+			|| player->upkeep->generate_level) {
+		return;
+	}
+
+	if (player->energy >= z_info->move_energy || gain <= 0) return;
+
+	/* Stop before the next turn that processes the world */
+	skip = (10 - turn % 10) % 10;
+
+	/* Stop before the turn after which the player could move */
+	skip = MIN(skip, (z_info->move_energy - player->energy - 1) / gain);
+
+	/* Stop before the first monster that would act */
+	skip = skip_monster_turns(skip);
+	if (skip <= 0) return;
+
+	player->energy += skip * gain;
+	turn += skip;
+}
+
 /**
  * Housekeeping on arriving on a new level
  */
@@ -1163,6 +1217,9 @@ void run_game_loop(void)
 
 			/* Count game turns */
 			turn++;
+
+			/* Pass over any following turns where nobody acts */
+			skip_quiet_turns();
 		}
 
 		/* Make a new level if requested */
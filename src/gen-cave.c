@@ -1689,45 +1689,93 @@ static void init_cavern(struct chunk *c, int density,
 }
 
 /**
- * Run a single pass of the cellular automata rules (4,5) on the dungeon.
+ * Run a single pass of the cellular automata rules (4,5) over a grid of
+ * walls.
+ * \param src holds 1 for each wall and 0 for each open grid
+ * \param dest is set to the result of the pass; its outer edge is left alone
+ * \param fixed holds 1 for each grid which may not change
+ * \param h is the height of the grid
+ * \param w is the width of the grid
+ *
+ * The neighbour count is a plain sum over the rows above and below, with no
+ * branches or bounds checks, so the compiler can vectorise the inner loop.
+ */
+static void cavern_step(const uint8_t *src, uint8_t *dest,
+		const uint8_t *fixed, int h, int w)
+{
+	int y, x;
+
+	for (y = 1; y < h - 1; y++) {
+		const uint8_t *above = src + (y - 1) * w;
+		const uint8_t *here = src + y * w;
+		const uint8_t *below = src + (y + 1) * w;
+		const uint8_t *keep = fixed + y * w;
+		uint8_t *out = dest + y * w;
+
+		for (x = 1; x < w - 1; x++) {
+			int count = above[x - 1] + above[x] + above[x + 1]
+				+ here[x - 1] + here[x + 1]
+				+ below[x - 1] + below[x] + below[x + 1];
+			uint8_t rule = (count > 5) | (here[x] & (count > 3));
+
+			out[x] = keep[x] ? here[x] : rule;
+		}
+	}
+}
+
+/**
+ * Run passes of the cellular automata rules (4,5) on the dungeon.
  * \param c is the chunk being mutated
+ * \param times is the number of passes to run
+ *
+ * Staircases and permanent walls never change; everything else is either
+ * floor or granite.  The passes run on a byte per grid, and only the grids
+ * which changed are written back to the chunk.
  */
-static void mutate_cavern(struct chunk *c) {
+static void mutate_cavern(struct chunk *c, int times) {
 	struct loc grid;
 	int h = c->height;
 	int w = c->width;
+	int i;
+	uint8_t *start = mem_zalloc(h * w * sizeof(uint8_t));
+	uint8_t *walls = mem_zalloc(h * w * sizeof(uint8_t));
+	uint8_t *temp = mem_zalloc(h * w * sizeof(uint8_t));
+	uint8_t *fixed = mem_zalloc(h * w * sizeof(uint8_t));
 
-	int *temp = mem_zalloc(h * w * sizeof(int));
-
-	for (grid.y = 1; grid.y < h - 1; grid.y++) {
-		for (grid.x = 1; grid.x < w - 1; grid.x++) {
-			int count = 8 - count_neighbors(NULL, c, grid,
-				square_ispassable, false);
-			if (square_isstairs(c, grid) ||
-					square_isperm(c, grid)) {
-				temp[grid_to_i(grid, w)] =
-					square(c, grid)->feat;
-			} else if (count > 5) {
-				temp[grid_to_i(grid, w)] = FEAT_GRANITE;
-			} else if (count < 4) {
-				temp[grid_to_i(grid, w)] = FEAT_FLOOR;
-			} else {
-				temp[grid_to_i(grid, w)] =
-					square(c, grid)->feat;
-			}
+	for (grid.y = 0; grid.y < h; grid.y++) {
+		for (grid.x = 0; grid.x < w; grid.x++) {
+			i = grid_to_i(grid, w);
+			start[i] = square_ispassable(c, grid) ? 0 : 1;
+			fixed[i] = (square_isstairs(c, grid) ||
+				square_isperm(c, grid)) ? 1 : 0;
 		}
 	}
+	memcpy(walls, start, h * w * sizeof(uint8_t));
+	memcpy(temp, start, h * w * sizeof(uint8_t));
+
+	for (i = 0; i < times; i++) {
+		uint8_t *swap = walls;
+
+		cavern_step(walls, temp, fixed, h, w);
+		walls = temp;
+		temp = swap;
+	}
 
 	for (grid.y = 1; grid.y < h - 1; grid.y++) {
 		for (grid.x = 1; grid.x < w - 1; grid.x++) {
-			if (temp[grid_to_i(grid, w)] == FEAT_GRANITE)
+			i = grid_to_i(grid, w);
+			if (walls[i] == start[i]) continue;
+			if (walls[i])
 				set_marked_granite(c, grid, SQUARE_WALL_SOLID);
 			else
-				square_set_feat(c, grid, temp[grid_to_i(grid, w)]);
+				square_set_feat(c, grid, FEAT_FLOOR);
 		}
 	}
 
+	mem_free(fixed);
 	mem_free(temp);
+	mem_free(walls);
+	mem_free(start);
 }
 
 /**
@@ -1768,48 +1816,56 @@ static int ignore_point(struct chunk *c, int colors[], struct loc grid) {
  * \param grid is the location
  * \param color is the color we are coloring
  * \param diagonal controls whether we can progress diagonally
+ * \param allowed is the set of grids which may be colored, laid out like the
+ * chunk's bitplanes
+ * \param visited is the set of grids already colored; the grids colored here
+ * are added to it
+ * \param frontier and next are scratch sets laid out like the chunk's
+ * bitplanes
+ *
+ * The region is filled a whole step, and a word of grids, at a time.
  */
 static void build_color_point(struct chunk *c, int colors[], int counts[],
-		bool *stairs, struct loc grid, int color, bool diagonal) {
-	int h = c->height;
+		bool *stairs, struct loc grid, int color, bool diagonal,
+		const uint64_t *allowed, uint64_t *visited, uint64_t *frontier,
+		uint64_t *next) {
 	int w = c->width;
-	int size = h * w;
-	struct queue *queue = q_new(size);
-
-	int *added = mem_zalloc(size * sizeof(int));
-
-	array_filler(added, 0, size);
-
-	q_push_int(queue, grid_to_i(grid, w));
-
-	counts[color] = 0;
-
-	while (q_len(queue) > 0) {
-		int i;
-		struct loc grid1;
-		int n1 = q_pop_int(queue);
-
-		i_to_grid(n1, w, &grid1);
-
-		if (ignore_point(c, colors, grid1)) continue;
-
-		colors[n1] = color;
-		counts[color]++;
-		if (stairs && square_isstairs(c, grid1)) stairs[color] = true;
-
-		for (i = 0; i < (diagonal ? 8 : 4); i++) {
-			struct loc grid2 = loc_sum(grid1, ddgrid_ddd[i]);
-			int n2 = grid_to_i(grid2, w);
-			if (ignore_point(c, colors, grid2)) continue;
-			if (added[n2]) continue;
-
-			q_push_int(queue, n2);
-			added[n2] = 1;
+	int stride = c->plane_stride;
+	int ymin = grid.y, ymax = grid.y;
+
+	/* Start from just this grid; other rows of frontier are never read */
+	memset(frontier + grid.y * stride, 0, stride * sizeof(*frontier));
+	frontier[cplane_word(c, grid)] = cplane_bit(grid);
+	visited[cplane_word(c, grid)] |= cplane_bit(grid);
+	colors[grid_to_i(grid, w)] = color;
+	counts[color] = 1;
+	if (stairs && square_isstairs(c, grid)) stairs[color] = true;
+
+	while (cave_bits_step(c, frontier, allowed, visited, next, diagonal,
+			&ymin, &ymax)) {
+		uint64_t *swap = frontier;
+		int y, word;
+
+		for (y = ymin; y <= ymax; y++) {
+			for (word = 0; word < stride; word++) {
+				uint64_t bits = next[y * stride + word];
+				int x;
+
+				for (x = word * CPLANE_BITS; bits; x++, bits >>= 1) {
+					struct loc grid1 = loc(x, y);
+
+					if (!(bits & 1)) continue;
+					colors[grid_to_i(grid1, w)] = color;
+					counts[color]++;
+					if (stairs && square_isstairs(c, grid1)) {
+						stairs[color] = true;
+					}
+				}
+			}
 		}
+		frontier = next;
+		next = swap;
 	}
-
-	mem_free(added);
-	q_free(queue);
 }
 
 /**
@@ -1829,15 +1885,38 @@ static void build_colors(struct chunk *c, int colors[], int counts[],
 	int h = c->height;
 	int w = c->width;
 	int color = 1;
+	uint64_t *allowed = cave_bits_new(c);
+	uint64_t *visited = cave_bits_new(c);
+	uint64_t *frontier = cave_bits_new(c);
+	uint64_t *next = cave_bits_new(c);
 
 	for (y = 0; y < h; y++) {
 		for (x = 0; x < w; x++) {
-			if (ignore_point(c, colors, loc(x, y))) continue;
-			build_color_point(c, colors, counts, stairs,
-				loc(x, y), color, diagonal);
+			struct loc grid = loc(x, y);
+
+			if (ignore_point(c, colors, grid)) continue;
+			allowed[cplane_word(c, grid)] |= cplane_bit(grid);
+		}
+	}
+
+	for (y = 0; y < h; y++) {
+		for (x = 0; x < w; x++) {
+			struct loc grid = loc(x, y);
+			int word = cplane_word(c, grid);
+
+			if (!(allowed[word] & ~visited[word] & cplane_bit(grid))) {
+				continue;
+			}
+			build_color_point(c, colors, counts, stairs, grid, color,
+				diagonal, allowed, visited, frontier, next);
 			color++;
 		}
 	}
+
+	mem_free(next);
+	mem_free(frontier);
+	mem_free(visited);
+	mem_free(allowed);
 }
 
 /**
@@ -2111,7 +2190,7 @@ static struct chunk *cavern_chunk(int depth, int h, int w,
 	for (tries = 0; tries < MAX_CAVERN_TRIES; tries++) {
 		/* Build a random cavern and mutate it a number of times */
 		init_cavern(c, density, join);
-		for (i = 0; i < times; i++) mutate_cavern(c);
+		mutate_cavern(c, times);
 
 		/* If there are enough open squares then we're done */
 		if (c->feat_count[FEAT_FLOOR] >= limit) {
@@ -54,6 +54,7 @@ struct chunk *chunk_write(struct chunk *c)
 		for (x = 0; x < new->width; x++) {
 			/* Terrain */
 			new->squares[y][x].feat = square(c, loc(x, y))->feat;
+			cave_update_planes(new, loc(x, y));
 			sqinfo_copy(square(new, loc(x, y))->info, square(c, loc(x, y))->info);
 		}
 	}
@@ -192,6 +193,32 @@ void symmetry_transform(struct loc *grid, int y0, int x0, int height, int width,
 	grid->x += x0;
 }
 
+/**
+ * Reduce a symmetry transform to the affine map that symmetry_transform()
+ * would apply to every grid, so a whole template can be remapped without
+ * redoing the rotation for each grid
+ * \param map is set to the equivalent affine map
+ * \param y0 how much the grid is being translated vertically
+ * \param x0 how much the grid is being translated horizontally
+ * \param height height of the chunk
+ * \param width width of the chunk
+ * \param rotate how much to rotate, in multiples of 90 degrees clockwise
+ * \param reflect whether to reflect horizontally
+ */
+void get_symmetry_map(struct symmetry_map *map, int y0, int x0, int height,
+	int width, int rotate, bool reflect)
+{
+	struct loc row = loc(0, 1), col = loc(1, 0);
+
+	map->origin = loc(0, 0);
+	symmetry_transform(&map->origin, y0, x0, height, width, rotate,
+		reflect);
+	symmetry_transform(&row, y0, x0, height, width, rotate, reflect);
+	symmetry_transform(&col, y0, x0, height, width, rotate, reflect);
+	map->dy = loc_diff(row, map->origin);
+	map->dx = loc_diff(col, map->origin);
+}
+
 /**
  * Select a random symmetry transformation subject to certain constraints.
  * \param height Is the height of the piece to transform.
@@ -369,6 +396,7 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 			/* Terrain */
 			dest->squares[dest_grid.y][dest_grid.x].feat =
 				square(source, grid)->feat;
+			cave_update_planes(dest, dest_grid);
 			sqinfo_copy(square(dest, dest_grid)->info,
 						square(source, grid)->info);
 
@@ -394,6 +422,7 @@ bool chunk_copy(struct chunk *dest, struct player *p, struct chunk *source,
 				while (trap) {
 					/* Adjust location */
 					trap->grid = dest_grid;
+					if (trap->timeout) dest->timed_traps++;
 					trap = trap->next;
 				}
 				source->squares[grid.y][grid.x].trap = NULL;
@@ -57,6 +57,10 @@ struct vault *vaults;
 static struct cave_profile *cave_profiles;
 struct dun_data *dun;
 struct room_template *room_templates;
+struct vault_type_index *vault_index;
+int vault_index_count;
+struct room_template_set *room_template_index;
+int room_template_index_count;
 
 static const struct {
 	const char *name;
@@ -312,6 +316,59 @@ static struct file_parser profile_parser = {
 };
 
 
+/**
+ * Compile the text of a vault or room template into the list of grids which
+ * need work when it is placed.
+ * \param layout is the layout to fill in
+ * \param text is the template text, row by row
+ * \param hgt is the height of the template
+ * \param wid is the width of the template
+ * \param second_pass holds the characters which need a second pass once
+ * all the features are in place
+ */
+static void compile_room_layout(struct room_layout *layout, const char *text,
+	int hgt, int wid, const char *second_pass)
+{
+	const char *t;
+	int x, y;
+
+	layout->n_grids = 0;
+	layout->n_placements = 0;
+	for (t = text, y = 0; t && y < hgt && *t; y++) {
+		for (x = 0; x < wid && *t; x++, t++) {
+			if (*t == ' ') continue;
+			layout->n_grids++;
+			if (strchr(second_pass, *t)) layout->n_placements++;
+		}
+	}
+	layout->grids = mem_zalloc(MAX(layout->n_grids, 1)
+		* sizeof(*layout->grids));
+	layout->placements = mem_zalloc(MAX(layout->n_placements, 1)
+		* sizeof(*layout->placements));
+	layout->n_grids = 0;
+	layout->n_placements = 0;
+	for (t = text, y = 0; t && y < hgt && *t; y++) {
+		for (x = 0; x < wid && *t; x++, t++) {
+			struct room_grid g = { (uint8_t) y, (uint8_t) x, *t };
+
+			if (*t == ' ') continue;
+			layout->grids[layout->n_grids++] = g;
+			if (strchr(second_pass, *t)) {
+				layout->placements[layout->n_placements++] = g;
+			}
+		}
+	}
+}
+
+/**
+ * Free a compiled layout
+ */
+static void free_room_layout(struct room_layout *layout)
+{
+	mem_free(layout->grids);
+	mem_free(layout->placements);
+}
+
 /**
  * Parsing functions for room_template.txt
  */
@@ -448,8 +505,15 @@ static errr run_parse_room(struct parser *p) {
 }
 
 static errr finish_parse_room(struct parser *p) {
+	struct room_template *t;
+
 	room_templates = parser_priv(p);
 	parser_destroy(p);
+
+	/* Compile the layouts; '#', '8' and '9' need a second pass */
+	for (t = room_templates; t; t = t->next) {
+		compile_room_layout(&t->layout, t->text, t->hgt, t->wid, "#89");
+	}
 	return 0;
 }
 
@@ -460,6 +524,7 @@ static void cleanup_room(void)
 		next = t->next;
 		mem_free(t->name);
 		mem_free(t->text);
+		free_room_layout(&t->layout);
 		mem_free(t);
 	}
 }
@@ -612,8 +677,29 @@ static errr run_parse_vault(struct parser *p) {
 }
 
 static errr finish_parse_vault(struct parser *p) {
+	struct vault *v;
+
 	vaults = parser_priv(p);
 	parser_destroy(p);
+
+	for (v = vaults; v; v = v->next) {
+		int i, n = 0;
+
+		/* Objects, monsters, traps and inner walls need a second pass */
+		compile_room_layout(&v->layout, v->text, v->hgt, v->wid,
+			"1234567890~$]|=\"!?_-,#@");
+
+		/* Most alphabetic characters signify monster races */
+		for (i = 0; i < v->layout.n_grids; i++) {
+			char code = v->layout.grids[i].code;
+
+			if (!isalpha((unsigned char)code) || code == 'x'
+					|| code == 'X' || strchr(v->races, code)) {
+				continue;
+			}
+			if (n < (int) sizeof(v->races) - 1) v->races[n++] = code;
+		}
+	}
 	return 0;
 }
 
@@ -625,6 +711,7 @@ static void cleanup_vault(void)
 		mem_free(v->name);
 		mem_free(v->typ);
 		mem_free(v->text);
+		free_room_layout(&v->layout);
 		mem_free(v);
 	}
 }
@@ -637,6 +724,166 @@ static struct file_parser vault_parser = {
 	cleanup_vault
 };
 
+/**
+ * Build the index of vaults by type and depth, so that random_vault() can
+ * choose without walking the whole vault list.
+ *
+ * For each type, the depths are split into ranges over which the set of
+ * allowed vaults does not change, and each range gets its own array.
+ */
+static void index_vaults(void)
+{
+	struct vault *v;
+	int n_types = 0;
+
+	/* Collect the distinct types */
+	vault_index_count = 0;
+	for (v = vaults; v; v = v->next) {
+		n_types++;
+	}
+	vault_index = mem_zalloc(MAX(n_types, 1) * sizeof(*vault_index));
+	for (v = vaults; v; v = v->next) {
+		int i;
+
+		if (!v->typ) continue;
+		for (i = 0; i < vault_index_count; i++) {
+			if (streq(vault_index[i].typ, v->typ)) break;
+		}
+		if (i == vault_index_count) {
+			vault_index[i].typ = v->typ;
+			vault_index_count++;
+		}
+	}
+
+	/* Split each type by depth */
+	for (int i = 0; i < vault_index_count; i++) {
+		struct vault_type_index *vt = &vault_index[i];
+		int n_vaults = 0, depth;
+
+		vt->max_depth = 0;
+		for (v = vaults; v; v = v->next) {
+			if (!v->typ || !streq(v->typ, vt->typ)) continue;
+			n_vaults++;
+			vt->max_depth = MAX(vt->max_depth, v->max_lev);
+		}
+		vt->depth_set = mem_zalloc((vt->max_depth + 1)
+			* sizeof(*vt->depth_set));
+
+		/* At most one new range starts per vault boundary, plus the first */
+		vt->sets = mem_zalloc((2 * n_vaults + 1) * sizeof(*vt->sets));
+		vt->n_sets = 0;
+		for (depth = 0; depth <= vt->max_depth; depth++) {
+			struct vault_set *set;
+			bool changed = (depth == 0);
+
+			/* Reuse the previous range unless some vault starts or ends */
+			for (v = vaults; v && !changed; v = v->next) {
+				if (!v->typ || !streq(v->typ, vt->typ)) continue;
+				if (v->min_lev == depth || v->max_lev + 1 == depth) {
+					changed = true;
+				}
+			}
+			if (!changed) {
+				vt->depth_set[depth] = vt->depth_set[depth - 1];
+				continue;
+			}
+
+			/* Gather the vaults allowed at this depth */
+			set = &vt->sets[vt->n_sets];
+			set->count = 0;
+			for (v = vaults; v; v = v->next) {
+				if (!v->typ || !streq(v->typ, vt->typ)) continue;
+				if (v->min_lev <= depth && v->max_lev >= depth) {
+					set->count++;
+				}
+			}
+			if (!set->count) {
+				vt->depth_set[depth] = -1;
+				continue;
+			}
+			set->vaults = mem_zalloc(set->count * sizeof(*set->vaults));
+			set->count = 0;
+			for (v = vaults; v; v = v->next) {
+				if (!v->typ || !streq(v->typ, vt->typ)) continue;
+				if (v->min_lev <= depth && v->max_lev >= depth) {
+					set->vaults[set->count++] = v;
+				}
+			}
+			vt->depth_set[depth] = vt->n_sets++;
+		}
+	}
+}
+
+/**
+ * Build the index of room templates by type and rating, so that
+ * random_room_template() can choose without walking the whole template list.
+ */
+static void index_room_templates(void)
+{
+	struct room_template *t;
+	int n_templates = 0;
+
+	room_template_index_count = 0;
+	for (t = room_templates; t; t = t->next) {
+		n_templates++;
+	}
+	room_template_index = mem_zalloc(MAX(n_templates, 1)
+		* sizeof(*room_template_index));
+	for (t = room_templates; t; t = t->next) {
+		struct room_template_set *set;
+		int i;
+
+		for (i = 0; i < room_template_index_count; i++) {
+			set = &room_template_index[i];
+			if (set->typ == t->typ && set->rat == t->rat) break;
+		}
+		set = &room_template_index[i];
+		if (i == room_template_index_count) {
+			set->typ = t->typ;
+			set->rat = t->rat;
+			room_template_index_count++;
+		}
+		set->count++;
+	}
+	for (int i = 0; i < room_template_index_count; i++) {
+		struct room_template_set *set = &room_template_index[i];
+
+		set->templates = mem_zalloc(set->count * sizeof(*set->templates));
+		set->count = 0;
+		for (t = room_templates; t; t = t->next) {
+			if (set->typ == t->typ && set->rat == t->rat) {
+				set->templates[set->count++] = t;
+			}
+		}
+	}
+}
+
+/**
+ * Free the vault and room template indexes
+ */
+static void cleanup_template_indexes(void)
+{
+	for (int i = 0; i < vault_index_count; i++) {
+		struct vault_type_index *vt = &vault_index[i];
+
+		for (int j = 0; j < vt->n_sets; j++) {
+			mem_free(vt->sets[j].vaults);
+		}
+		mem_free(vt->sets);
+		mem_free(vt->depth_set);
+	}
+	mem_free(vault_index);
+	vault_index = NULL;
+	vault_index_count = 0;
+
+	for (int i = 0; i < room_template_index_count; i++) {
+		mem_free(room_template_index[i].templates);
+	}
+	mem_free(room_template_index);
+	room_template_index = NULL;
+	room_template_index_count = 0;
+}
+
 static void run_template_parser(void) {
 	/* Initialize room info */
 	event_signal_message(EVENT_INITSTATUS, 0,
@@ -655,6 +902,10 @@ static void run_template_parser(void) {
 						 "Initializing arrays... (vaults)");
 	if (run_parser(&vault_parser))
 		quit("Cannot initialize vaults");
+
+	/* Index the templates for quick selection */
+	index_room_templates();
+	index_vaults();
 }
 
 
@@ -663,6 +914,7 @@ static void run_template_parser(void) {
  */
 static void cleanup_template_parser(void)
 {
+	cleanup_template_indexes();
 	cleanup_parser(&profile_parser);
 	cleanup_parser(&room_parser);
 	cleanup_parser(&vault_parser);
@@ -258,6 +258,26 @@ struct room_profile {
 };
 
 
+/**
+ * A single non-blank grid of a vault or room template
+ */
+struct room_grid {
+    uint8_t y;			/*!< Row in the template */
+    uint8_t x;			/*!< Column in the template */
+    char code;			/*!< Template character for the grid */
+};
+
+/**
+ * Vault or room template text compiled at load, so that placement only visits
+ * the grids which need work
+ */
+struct room_layout {
+    int n_grids;				/*!< Number of non-blank grids */
+    struct room_grid *grids;	/*!< Non-blank grids, in text order */
+    int n_placements;			/*!< Number of grids with second pass work */
+    struct room_grid *placements;	/*!< Those grids, in text order */
+};
+
 /*
  * Information about vault generation
  */
@@ -278,6 +298,9 @@ struct vault {
 
     uint8_t min_lev;		/*!< Minimum allowable level, if specified. */
     uint8_t max_lev;		/*!< Maximum allowable level, if specified. */
+
+    struct room_layout layout;	/*!< Compiled layout */
+    char races[31];		/*!< Monster race symbols used, in text order */
 };
 
 
@@ -301,6 +324,39 @@ struct room_template {
     uint8_t wid;		/*!< Room width */
     uint8_t dor;		/*!< Random door options */
     uint8_t tval;		/*!< tval for objects in this room */
+
+    struct room_layout layout;	/*!< Compiled layout */
+};
+
+/**
+ * The vaults of a single type which are allowed over a contiguous range of
+ * depths; any of them is an equally likely choice anywhere in that range
+ */
+struct vault_set {
+    int count;					/*!< Number of vaults in the set */
+    struct vault **vaults;		/*!< The vaults, in vault.txt order */
+};
+
+/**
+ * Index of the vaults of a single type, built once vault.txt is parsed
+ */
+struct vault_type_index {
+    const char *typ;			/*!< Vault type, shared with the vaults */
+    int n_sets;					/*!< Number of distinct depth ranges */
+    struct vault_set *sets;		/*!< Vaults for each depth range */
+    int max_depth;				/*!< Last depth covered by depth_set */
+    int *depth_set;				/*!< Index into sets for each depth, -1 if
+									none of the vaults are allowed there */
+};
+
+/**
+ * The room templates sharing a type and rating
+ */
+struct room_template_set {
+    uint8_t typ;				/*!< Room type */
+    uint8_t rat;				/*!< Room rating */
+    int count;					/*!< Number of templates in the set */
+    struct room_template **templates;	/*!< The templates */
 };
 
 /**
@@ -312,9 +368,23 @@ struct room_template {
 #define SYMTR_FLAG_FORCE_REF (4)
 #define SYMTR_MAX_WEIGHT (32768)
 
+/**
+ * A symmetry transform reduced to its affine form:  the template grid (y, x)
+ * goes to origin + y * dy + x * dx.
+ */
+struct symmetry_map {
+    struct loc origin;
+    struct loc dy;
+    struct loc dx;
+};
+
 extern struct dun_data *dun;
 extern struct vault *vaults;
 extern struct room_template *room_templates;
+extern struct vault_type_index *vault_index;
+extern int vault_index_count;
+extern struct room_template_set *room_template_index;
+extern int room_template_index_count;
 
 /* generate.c */
 void prepare_next_level(struct player *p);
@@ -355,6 +425,8 @@ bool chunk_find(struct chunk *c);
 struct chunk *chunk_find_adjacent(int depth, bool above);
 void symmetry_transform(struct loc *grid, int y0, int x0, int height, int width,
 	int rotate, bool reflect);
+void get_symmetry_map(struct symmetry_map *map, int y0, int x0, int height,
+	int width, int rotate, bool reflect);
 void get_random_symmetry_transform(int height, int width, int flags,
 	int transpose_weight, int *rotate, bool *reflect,
 	int *theight, int *twidth);
@@ -4548,6 +4548,13 @@ bool init_angband(void)
 /**
  * Free all the stuff initialised in init_angband()
  */
+#ifdef MEM_ACCOUNTING
+static void write_memory_line(void *data, const char *line)
+{
+	file_putf((ang_file *)data, "%s\n", line);
+}
+#endif
+
 void cleanup_angband(void)
 {
 	int i;
@@ -4582,6 +4589,21 @@ void cleanup_angband(void)
 
 	if (play_again) return;
 
+#ifdef MEM_ACCOUNTING
+	/* Record how memory was used before the last of it goes */
+	if (ANGBAND_DIR_USER) {
+		char path[1024];
+		ang_file *f;
+
+		path_build(path, sizeof(path), ANGBAND_DIR_USER, "memory.txt");
+		f = file_open(path, MODE_WRITE, FTYPE_TEXT);
+		if (f) {
+			mem_report(write_memory_line, f);
+			file_close(f);
+		}
+	}
+#endif
+
 	/* Free the format() buffer */
 	vformat_kill();
 
@@ -984,7 +984,7 @@ int rd_misc(void)
 				quit("Could not parse random artifacts.");
 			}
 		} else {
-			do_randart(seed_randart, true);
+			do_randart(seed_randart, true, true);
 		}
 		deactivate_randart_file();
 	}
@@ -1192,8 +1192,12 @@ int rd_gear(void)
 
 /**
  * Read store contents
+ *
+ * \param rd_item_version is the function to read each item.
+ * \param has_maint_days is whether each store records the days of
+ * maintenance it is owed; older savefiles don't.
  */
-static int rd_stores_aux(rd_item_t rd_item_version)
+static int rd_stores_aux(rd_item_t rd_item_version, bool has_maint_days)
 {
 	int i;
 	uint16_t tmp16u;
@@ -1209,14 +1213,19 @@ static int rd_stores_aux(rd_item_t rd_item_version)
 		struct store *store = (i < z_info->store_max) ?
 			 &stores[i] : NULL;
 		uint8_t own, num;
+		uint16_t maint_days = 0;
 
 		/* Read the basic info */
 		rd_byte(&own);
 		rd_byte(&num);
+		if (has_maint_days) {
+			rd_u16b(&maint_days);
+		}
 
 		/* XXX: refactor into store.c */
 		if (store) {
 			store->owner = store_ownerbyidx(store, own);
+			store->maint_days = maint_days;
 		}
 
 		/* Read the items */
@@ -1264,7 +1273,8 @@ static int rd_stores_aux(rd_item_t rd_item_version)
 /**
  * Read the stores - wrapper functions
  */
-int rd_stores(void) { return rd_stores_aux(rd_item); }
+int rd_stores_1(void) { return rd_stores_aux(rd_item, false); }
+int rd_stores(void) { return rd_stores_aux(rd_item, true); }
 
 
 /**
@@ -1492,6 +1502,7 @@ static int rd_traps_aux(struct chunk *c)
 			/* Put the trap at the front of the grid trap list */
 			trap->next = square_trap(c, grid);
 			square_set_trap(c, grid, trap);
+			if (trap->timeout) c->timed_traps++;
 
 			/* Set decoy if appropriate */
 			if ((trap->kind == lookup_trap("decoy")) &&
@@ -0,0 +1,555 @@
+/**
+ * \file main-bench.c
+ * \brief Headless front end for timing the user interface
+ *
+ * Replays a script of keypresses against a savefile with no-op terms and
+ * reports how long Term_fresh(), redraw_stuff(), prt_map() and the event
+ * handlers took for each keypress, along with how many cells went through
+ * the text and pict hooks.
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+#include "game-event.h"
+#include "game-world.h"
+#include "grafmode.h"
+#include "main.h"
+#include "ui-event.h"
+#include "ui-prefs.h"
+#include "ui-term.h"
+
+#ifdef USE_BENCH
+
+#include <time.h>
+
+/* Longest line in a keypress script */
+#define BENCH_LINE_MAX 1024
+/* Deepest nesting of event handlers that is timed separately */
+#define BENCH_EVENT_DEPTH 32
+/* Escapes to get into the game before giving up */
+#define BENCH_STARTUP_KEYS 100
+
+/**
+ * What is timed for each frame: the frame itself, from handing over a
+ * keypress to the next wait for one, and then each probe_point
+ */
+enum {
+	BENCH_FRAME,
+	BENCH_PROBE_FIRST,
+
+	BENCH_SERIES_MAX = BENCH_PROBE_FIRST + PROBE_MAX
+};
+
+static const char *series_names[BENCH_SERIES_MAX] = {
+	"frame",
+	"Term_fresh",
+	"redraw_stuff",
+	"prt_map",
+	"handlers"
+};
+
+/* Names for the events the main screen and subwindows handle */
+static const char *event_names[N_GAME_EVENTS] = {
+	[EVENT_MAP] = "map",
+	[EVENT_STATS] = "stats",
+	[EVENT_HP] = "hp",
+	[EVENT_MANA] = "mana",
+	[EVENT_AC] = "ac",
+	[EVENT_EXPERIENCE] = "experience",
+	[EVENT_PLAYERLEVEL] = "playerlevel",
+	[EVENT_PLAYERTITLE] = "playertitle",
+	[EVENT_GOLD] = "gold",
+	[EVENT_MONSTERHEALTH] = "monsterhealth",
+	[EVENT_DUNGEONLEVEL] = "dungeonlevel",
+	[EVENT_PLAYERSPEED] = "playerspeed",
+	[EVENT_RACE_CLASS] = "race_class",
+	[EVENT_STUDYSTATUS] = "studystatus",
+	[EVENT_STATUS] = "status",
+	[EVENT_DETECTIONSTATUS] = "detectionstatus",
+	[EVENT_FEELING] = "feeling",
+	[EVENT_LIGHT] = "light",
+	[EVENT_STATE] = "state",
+	[EVENT_PLAYERMOVED] = "playermoved",
+	[EVENT_SEEFLOOR] = "seefloor",
+	[EVENT_INVENTORY] = "inventory",
+	[EVENT_EQUIPMENT] = "equipment",
+	[EVENT_ITEMLIST] = "itemlist",
+	[EVENT_MONSTERLIST] = "monsterlist",
+	[EVENT_MONSTERTARGET] = "monstertarget",
+	[EVENT_OBJECTTARGET] = "objecttarget",
+	[EVENT_MESSAGE] = "message",
+	[EVENT_MESSAGE_FLUSH] = "message_flush",
+	[EVENT_CHECK_INTERRUPT] = "check_interrupt",
+	[EVENT_REFRESH] = "refresh",
+	[EVENT_NEW_LEVEL_DISPLAY] = "new_level_display",
+	[EVENT_ANIMATE] = "animate",
+	[EVENT_END] = "end"
+};
+
+struct bench_series {
+	uint64_t *ns;
+	size_t n;
+	size_t alloc;
+};
+
+static struct {
+	/* the script, and how far it has got */
+	struct keypress *keys;
+	size_t n_keys;
+	size_t next_key;
+	int repeats;
+	int startup_keys;
+
+	FILE *out;
+	bool in_frame;
+	uint64_t frame_start;
+
+	/* time so far in this frame for each series, and how it is nested */
+	uint64_t current[BENCH_SERIES_MAX];
+	uint64_t started[PROBE_MAX];
+	int depth[PROBE_MAX];
+
+	/* handlers still running, innermost last */
+	struct {
+		int type;
+		uint64_t started;
+	} events[BENCH_EVENT_DEPTH];
+	int event_depth;
+	uint64_t event_ns[N_GAME_EVENTS];
+	uint32_t event_calls[N_GAME_EVENTS];
+
+	struct bench_series series[BENCH_SERIES_MAX];
+
+	uint64_t text_cells;
+	uint64_t pict_cells;
+	uint64_t wipe_cells;
+	uint64_t text_calls;
+	uint64_t pict_calls;
+} bench;
+
+static term bench_terms[ANGBAND_TERM_MAX];
+static void (*quit_nested)(const char *) = NULL;
+
+/**
+ * Returns a time in nanoseconds; only differences are meaningful
+ */
+static uint64_t bench_now(void)
+{
+#ifdef UNIX
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+	}
+#endif
+	return (uint64_t)clock() * (1000000000 / CLOCKS_PER_SEC);
+}
+
+static void series_add(struct bench_series *s, uint64_t ns)
+{
+	if (s->n == s->alloc) {
+		s->alloc = (s->alloc) ? 2 * s->alloc : 256;
+		s->ns = mem_realloc(s->ns, s->alloc * sizeof(*s->ns));
+	}
+	s->ns[s->n++] = ns;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+	uint64_t ia = *(const uint64_t *)a, ib = *(const uint64_t *)b;
+
+	return (ia < ib) ? -1 : ((ia > ib) ? 1 : 0);
+}
+
+/**
+ * Nearest-rank percentile of sorted values
+ */
+static uint64_t percentile(const uint64_t *sorted, size_t n, int pct)
+{
+	size_t rank = (n * (size_t)pct + 99) / 100;
+
+	return sorted[(rank > 0) ? rank - 1 : 0];
+}
+
+/**
+ * Charge whatever is still running to the frame that is ending, and start
+ * it again for the next one; a handler can wait for a key, for instance
+ */
+static void frame_close(uint64_t now)
+{
+	int i;
+
+	for (i = 0; i < PROBE_MAX; i++) {
+		if (bench.depth[i] > 0) {
+			bench.current[BENCH_PROBE_FIRST + i] +=
+				now - bench.started[i];
+			bench.started[i] = now;
+		}
+	}
+	for (i = 0; i < bench.event_depth; i++) {
+		bench.event_ns[bench.events[i].type] +=
+			now - bench.events[i].started;
+		bench.events[i].started = now;
+	}
+
+	bench.current[BENCH_FRAME] = now - bench.frame_start;
+	for (i = 0; i < BENCH_SERIES_MAX; i++) {
+		series_add(&bench.series[i], bench.current[i]);
+		bench.current[i] = 0;
+	}
+	bench.in_frame = false;
+}
+
+static void bench_probe(enum probe_point point, int detail, bool leaving)
+{
+	uint64_t now;
+
+	if (!bench.in_frame) return;
+
+	now = bench_now();
+	if (point == PROBE_EVENT) {
+		if (!leaving) {
+			if (bench.event_depth < BENCH_EVENT_DEPTH) {
+				bench.events[bench.event_depth].type = detail;
+				bench.events[bench.event_depth].started = now;
+			}
+			++bench.event_depth;
+		} else if (bench.event_depth > 0) {
+			--bench.event_depth;
+			if (bench.event_depth < BENCH_EVENT_DEPTH) {
+				int type = bench.events[bench.event_depth].type;
+
+				bench.event_ns[type] += now
+					- bench.events[bench.event_depth].started;
+				++bench.event_calls[type];
+			}
+		}
+	}
+
+	/* Only the outermost call counts towards the series */
+	if (!leaving) {
+		if (bench.depth[point]++ == 0) {
+			bench.started[point] = now;
+		}
+	} else if (bench.depth[point] > 0 && --bench.depth[point] == 0) {
+		bench.current[BENCH_PROBE_FIRST + point] +=
+			now - bench.started[point];
+	}
+}
+
+static void report(void)
+{
+	FILE *fp = bench.out ? bench.out : stdout;
+	size_t n = bench.series[BENCH_FRAME].n;
+	uint64_t *sorted;
+	int order[N_GAME_EVENTS];
+	int i, j, n_order = 0;
+
+	fprintf(fp, "frames: %lu\n", (unsigned long)n);
+	if (n == 0) return;
+
+	fprintf(fp, "%-14s %10s %10s %10s %10s %10s  (microseconds)\n",
+		"", "mean", "p50", "p90", "p99", "max");
+	sorted = mem_alloc(n * sizeof(*sorted));
+	for (i = 0; i < BENCH_SERIES_MAX; i++) {
+		uint64_t total = 0;
+		size_t k;
+
+		memcpy(sorted, bench.series[i].ns, n * sizeof(*sorted));
+		qsort(sorted, n, sizeof(*sorted), cmp_u64);
+		for (k = 0; k < n; k++) {
+			total += sorted[k];
+		}
+		fprintf(fp, "%-14s %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+			series_names[i], total / 1000.0 / n,
+			percentile(sorted, n, 50) / 1000.0,
+			percentile(sorted, n, 90) / 1000.0,
+			percentile(sorted, n, 99) / 1000.0,
+			sorted[n - 1] / 1000.0);
+	}
+	mem_free(sorted);
+
+	fprintf(fp, "\n%-14s %12s %12s %12s\n", "cells", "total",
+		"per frame", "per call");
+	fprintf(fp, "%-14s %12llu %12.1f %12.1f\n", "text_hook",
+		(unsigned long long)bench.text_cells,
+		(double)bench.text_cells / n, (bench.text_calls) ?
+		(double)bench.text_cells / bench.text_calls : 0.0);
+	fprintf(fp, "%-14s %12llu %12.1f %12.1f\n", "pict_hook",
+		(unsigned long long)bench.pict_cells,
+		(double)bench.pict_cells / n, (bench.pict_calls) ?
+		(double)bench.pict_cells / bench.pict_calls : 0.0);
+	fprintf(fp, "%-14s %12llu %12.1f\n", "wipe_hook",
+		(unsigned long long)bench.wipe_cells,
+		(double)bench.wipe_cells / n);
+
+	/* Handlers by event, the most expensive first */
+	for (i = 0; i < N_GAME_EVENTS; i++) {
+		if (!bench.event_calls[i]) continue;
+		for (j = n_order; j > 0 &&
+				bench.event_ns[order[j - 1]] < bench.event_ns[i]; j--) {
+			order[j] = order[j - 1];
+		}
+		order[j] = i;
+		++n_order;
+	}
+	if (n_order == 0) return;
+	fprintf(fp, "\n%-18s %10s %14s %12s\n", "handlers by event", "calls",
+		"total (us)", "per call");
+	for (i = 0; i < n_order; i++) {
+		int type = order[i];
+		char name[32];
+
+		if (event_names[type]) {
+			my_strcpy(name, event_names[type], sizeof(name));
+		} else {
+			strnfmt(name, sizeof(name), "event %d", type);
+		}
+		fprintf(fp, "%-18s %10lu %14.1f %12.2f\n", name,
+			(unsigned long)bench.event_calls[type],
+			bench.event_ns[type] / 1000.0,
+			bench.event_ns[type] / 1000.0 / bench.event_calls[type]);
+	}
+}
+
+/**
+ * Hand over the next scripted key; returns false when the script is done
+ */
+static bool next_key(void)
+{
+	if (bench.next_key == bench.n_keys) {
+		if (bench.repeats <= 1 || bench.n_keys == 0) return false;
+		--bench.repeats;
+		bench.next_key = 0;
+	}
+	Term_keypress(bench.keys[bench.next_key].code,
+		bench.keys[bench.next_key].mods);
+	++bench.next_key;
+	return true;
+}
+
+static errr term_xtra_bench(int n, int v)
+{
+	switch (n) {
+		case TERM_XTRA_EVENT: {
+			/* Only a wait for a key ends a frame */
+			if (!v) return 0;
+
+			if (bench.in_frame) {
+				frame_close(bench_now());
+			}
+
+			/* Get past the splash screen and into the game */
+			if (!character_dungeon) {
+				if (++bench.startup_keys > BENCH_STARTUP_KEYS) {
+					quit("init-bench: the savefile needs a "
+						"living character");
+				}
+				Term_keypress(ESCAPE, 0);
+				return 0;
+			}
+
+			if (!next_key()) {
+				report();
+				quit(NULL);
+			}
+			bench.in_frame = true;
+			bench.frame_start = bench_now();
+			return 0;
+		}
+
+		default:
+			/* No delays, sounds or screen to flush */
+			return 0;
+	}
+}
+
+static errr term_curs_bench(int x, int y)
+{
+	return 0;
+}
+
+static errr term_wipe_bench(int x, int y, int n)
+{
+	if (bench.in_frame) bench.wipe_cells += n;
+	return 0;
+}
+
+static errr term_text_bench(int x, int y, int n, int a, const wchar_t *s)
+{
+	if (bench.in_frame) {
+		bench.text_cells += n;
+		++bench.text_calls;
+	}
+	return 0;
+}
+
+static errr term_pict_bench(int x, int y, int n, const int *ap,
+		const wchar_t *cp, const int *tap, const wchar_t *tcp)
+{
+	if (bench.in_frame) {
+		bench.pict_cells += n;
+		++bench.pict_calls;
+	}
+	return 0;
+}
+
+static void term_data_link(int i)
+{
+	term *t = &bench_terms[i];
+
+	term_init(t, 80, 24, 256);
+
+	t->higher_pict = true;
+	t->xtra_hook = term_xtra_bench;
+	t->curs_hook = term_curs_bench;
+	t->wipe_hook = term_wipe_bench;
+	t->text_hook = term_text_bench;
+	t->pict_hook = term_pict_bench;
+
+	if (i == 0) {
+		Term_activate(t);
+	}
+
+	angband_term[i] = t;
+}
+
+/**
+ * Read the script: one keymap-style action (as in a pref file) per line,
+ * with blank lines and lines starting with '#' ignored
+ */
+static bool load_script(const char *path)
+{
+	ang_file *f = file_open(path, MODE_READ, FTYPE_TEXT);
+	char line[BENCH_LINE_MAX];
+	size_t alloc = 0;
+
+	if (!f) {
+		printf("init-bench: cannot open script '%s'\n", path);
+		return false;
+	}
+	while (file_getl(f, line, sizeof(line))) {
+		struct keypress keys[BENCH_LINE_MAX];
+		size_t k;
+
+		if (!line[0] || line[0] == '#') continue;
+		keypress_from_text(keys, N_ELEMENTS(keys), line);
+		for (k = 0; k < N_ELEMENTS(keys) && keys[k].type == EVT_KBRD;
+				k++) {
+			if (bench.n_keys == alloc) {
+				alloc = (alloc) ? 2 * alloc : 256;
+				bench.keys = mem_realloc(bench.keys,
+					alloc * sizeof(*bench.keys));
+			}
+			bench.keys[bench.n_keys++] = keys[k];
+		}
+	}
+	file_close(f);
+	return true;
+}
+
+static void quit_hook_bench(const char *s)
+{
+	int i;
+
+	probe_aux = NULL;
+	if (bench.out) {
+		fclose(bench.out);
+		bench.out = NULL;
+	}
+	for (i = 0; i < BENCH_SERIES_MAX; i++) {
+		mem_free(bench.series[i].ns);
+	}
+	mem_free(bench.keys);
+	if (use_graphics != GRAPHICS_NONE) {
+		close_graphics_modes();
+	}
+
+	if (quit_nested) (*quit_nested)(s);
+}
+
+const char help_bench[] =
+	"Benchmark mode, subopts\n"
+	"              -k fname    Replay keys from fname, one keymap action\n"
+	"                          per line (required); needs a savefile with\n"
+	"                          a living character\n"
+	"              -r count    Play the script that many times (default 1)\n"
+	"              -o fname    Write the report to fname, not stdout\n"
+	"              -w count    Use that many terms, at most 8 (default 8)\n"
+	"              -g mode     Use the graphics mode with that id";
+
+errr init_bench(int argc, char *argv[])
+{
+	const char *script = NULL, *outpath = NULL;
+	int n_terms = ANGBAND_TERM_MAX, graf = GRAPHICS_NONE;
+	int i;
+
+	bench.repeats = 1;
+
+	/* Skip over argv[0] */
+	for (i = 1; i < argc; i++) {
+		if (i + 1 < argc && streq(argv[i], "-k")) {
+			script = argv[++i];
+		} else if (i + 1 < argc && streq(argv[i], "-o")) {
+			outpath = argv[++i];
+		} else if (i + 1 < argc && streq(argv[i], "-r")) {
+			bench.repeats = atoi(argv[++i]);
+			bench.repeats = MAX(1, bench.repeats);
+		} else if (i + 1 < argc && streq(argv[i], "-w")) {
+			n_terms = atoi(argv[++i]);
+			n_terms = MIN(MAX(1, n_terms), ANGBAND_TERM_MAX);
+		} else if (i + 1 < argc && streq(argv[i], "-g")) {
+			graf = atoi(argv[++i]);
+		} else {
+			printf("init-bench: bad argument '%s'\n", argv[i]);
+			return 1;
+		}
+	}
+	if (!script) {
+		printf("init-bench: need a script, -k fname\n");
+		return 1;
+	}
+	if (!load_script(script)) return 1;
+	if (outpath) {
+		bench.out = fopen(outpath, "w");
+		if (!bench.out) {
+			printf("init-bench: cannot write '%s'\n", outpath);
+			return 1;
+		}
+	}
+
+	if (graf != GRAPHICS_NONE) {
+		graphics_mode *mode;
+
+		init_graphics_modes();
+		mode = get_graphics_mode(graf);
+		if (!mode || mode->grafID != graf) {
+			printf("init-bench: no graphics mode %d\n", graf);
+			return 1;
+		}
+		current_graphics_mode = mode;
+		use_graphics = mode->grafID;
+	}
+
+	for (i = n_terms - 1; i >= 0; i--) {
+		term_data_link(i);
+	}
+
+	quit_nested = quit_aux;
+	quit_aux = quit_hook_bench;
+	probe_aux = bench_probe;
+
+	return 0;
+}
+
+#endif /* USE_BENCH */
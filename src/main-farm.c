@@ -0,0 +1,630 @@
+/**
+ * \file main-farm.c
+ * \brief Headless front end that runs many borgs and reports how they did
+ *
+ * The process started by the user never plays.  It forks one child per run,
+ * a few at a time, and each child carries on as an ordinary front end with
+ * no-op terms: it makes a character from its own seed, hands it to the borg
+ * and, once the borg dies, stops or runs out of turns or time, sends one
+ * record back through a pipe.  The parent writes the records to a CSV file,
+ * and to a SQLite database in the stats directory when the stats front end
+ * is built as well, then prints a summary.
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+#include "game-world.h"
+#include "main.h"
+#include "player.h"
+#include "ui-birth.h"
+#include "ui-game.h"
+#include "ui-menu.h"
+#include "ui-prefs.h"
+#include "ui-term.h"
+
+#ifdef USE_FARM
+
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifdef USE_STATS
+#include "stats/db.h"
+#endif
+
+/* Keys to get from the splash screen into the dungeon before giving up */
+#define FARM_STARTUP_KEYS 100
+/* Times to try getting the borg going before giving up */
+#define FARM_BORG_TRIES 5
+/* Grace, in seconds, past the time limit before a child is killed */
+#define FARM_GRACE 60
+/* Most causes of death listed in the summary */
+#define FARM_CAUSES_SHOWN 10
+
+extern bool borg_active;
+
+/**
+ * What a child sends back; plain old data so it can go through a pipe
+ */
+struct farm_result {
+	int run;
+	uint32_t seed;
+	char race[32];
+	char class[32];
+	int clvl;
+	int max_depth;
+	int32_t game_turns;
+	uint32_t player_turns;
+	double secs;
+	char outcome[16];
+	char cause[80];
+};
+
+/**
+ * Where a child has got to
+ */
+enum {
+	FARM_SPLASH,
+	FARM_BIRTH,
+	FARM_BORG
+};
+
+static struct {
+	/* set from the command line */
+	int jobs;
+	int runs;
+	uint32_t seed;
+	int32_t max_turns;
+	int max_secs;
+	const char *race;
+	const char *class;
+	const char *csv;
+
+	/* in a child */
+	int run;
+	int fd;
+	int stage;
+	int keys;
+	int borg_tries;
+	bool borg_seen;
+	int32_t start_turn;
+	uint64_t start_ns;
+	struct keypress birth[8];
+	int n_birth;
+	int next_birth;
+} farm;
+
+static term farm_term;
+
+/**
+ * Returns a time in nanoseconds; only differences are meaningful
+ */
+static uint64_t farm_now(void)
+{
+	struct timespec ts;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &ts) == 0) {
+		return (uint64_t)ts.tv_sec * 1000000000 + (uint64_t)ts.tv_nsec;
+	}
+	return (uint64_t)clock() * (1000000000 / CLOCKS_PER_SEC);
+}
+
+/**
+ * Menu index of the race called name, or a random one if name is NULL
+ */
+static int farm_pick_race(const char *name)
+{
+	struct player_race *r;
+	int n = 0;
+
+	for (r = races; r; r = r->next) {
+		if (name && !my_stricmp(r->name, name)) return r->ridx;
+		n++;
+	}
+	if (name) quit_fmt("init-farm: no race '%s'", name);
+	return randint0(n);
+}
+
+/**
+ * Menu index of the class called name, or a random one if name is NULL
+ */
+static int farm_pick_class(const char *name)
+{
+	struct player_class *c;
+	int n = 0;
+
+	for (c = classes; c; c = c->next) {
+		if (name && !my_stricmp(c->name, name)) return c->cidx;
+		n++;
+	}
+	if (name) quit_fmt("init-farm: no class '%s'", name);
+	return randint0(n);
+}
+
+/**
+ * Send the record for this run to the parent and stop
+ */
+static void farm_finish(const char *outcome)
+{
+	struct farm_result res;
+	const char *p;
+	size_t left;
+
+	memset(&res, 0, sizeof(res));
+	res.run = farm.run;
+	res.seed = farm.seed + farm.run;
+	if (player->race) {
+		my_strcpy(res.race, player->race->name, sizeof(res.race));
+	}
+	if (player->class) {
+		my_strcpy(res.class, player->class->name, sizeof(res.class));
+	}
+	res.clvl = player->lev;
+	res.max_depth = player->max_depth;
+	res.game_turns = turn - farm.start_turn;
+	res.player_turns = player->total_energy / 100;
+	res.secs = (farm_now() - farm.start_ns) / 1e9;
+	my_strcpy(res.outcome, outcome, sizeof(res.outcome));
+	if (player->is_dead) {
+		my_strcpy(res.cause, player->died_from, sizeof(res.cause));
+	}
+
+	p = (const char *)&res;
+	left = sizeof(res);
+	while (left) {
+		ssize_t n = write(farm.fd, p, left);
+
+		if (n <= 0) break;
+		p += n;
+		left -= n;
+	}
+	close(farm.fd);
+	quit(NULL);
+}
+
+/**
+ * Work out the keys that make this run's character
+ */
+static void farm_plan_birth(void)
+{
+	struct keypress key = { EVT_KBRD, 0, 0 };
+
+	Rand_state_init(farm.seed + farm.run);
+
+	farm.n_birth = 0;
+	key.code = all_letters_nohjkl[farm_pick_race(farm.race)];
+	farm.birth[farm.n_birth++] = key;
+	key.code = KC_ENTER;
+	farm.birth[farm.n_birth++] = key;
+	key.code = all_letters_nohjkl[farm_pick_class(farm.class)];
+	farm.birth[farm.n_birth++] = key;
+	key.code = KC_ENTER;
+	farm.birth[farm.n_birth++] = key;
+}
+
+/**
+ * The game wants a key: get it through birth, start the borg, and notice
+ * when the borg has finished
+ */
+static void farm_wait(void)
+{
+	if (!character_dungeon) {
+		if (++farm.keys > FARM_STARTUP_KEYS) {
+			farm_finish("birth failed");
+		}
+		if (farm.stage == FARM_SPLASH) {
+			farm_plan_birth();
+			farm.stage = FARM_BIRTH;
+			Term_keypress(ESCAPE, 0);
+		} else if (farm.next_birth < farm.n_birth) {
+			Term_keypress(farm.birth[farm.next_birth].code, 0);
+			farm.next_birth++;
+		} else {
+			/* Take the defaults for everything else */
+			Term_keypress(KC_ENTER, 0);
+		}
+		return;
+	}
+
+	if (farm.stage == FARM_BORG && farm.borg_seen) {
+		farm_finish(player->is_dead ? "died" : "stopped");
+	}
+
+	if (++farm.borg_tries > FARM_BORG_TRIES) {
+		farm_finish("no borg");
+	}
+	if (farm.stage != FARM_BORG) {
+		farm.stage = FARM_BORG;
+		farm.start_turn = turn;
+		farm.start_ns = farm_now();
+	}
+
+	/* Skip the warning about the borg, then start it */
+	player->noscore |= NOSCORE_BORG;
+	Term_keypress(ESCAPE, 0);
+	Term_keypress(KTRL('Z'), 0);
+	Term_keypress('z', 0);
+}
+
+/**
+ * The borg polls for a user key while it plays; check the limits then
+ */
+static void farm_poll(void)
+{
+	if (farm.stage != FARM_BORG || !borg_active) return;
+
+	farm.borg_seen = true;
+	if (farm.max_turns && turn - farm.start_turn >= farm.max_turns) {
+		farm_finish("turn limit");
+	}
+	if (farm.max_secs
+			&& farm_now() - farm.start_ns
+			>= (uint64_t)farm.max_secs * 1000000000) {
+		farm_finish("time limit");
+	}
+}
+
+static errr term_xtra_farm(int n, int v)
+{
+	if (n == TERM_XTRA_EVENT) {
+		if (v) {
+			farm_wait();
+		} else {
+			farm_poll();
+		}
+	}
+
+	/* No delays, sounds or screen to flush */
+	return 0;
+}
+
+static errr term_curs_farm(int x, int y)
+{
+	return 0;
+}
+
+static errr term_wipe_farm(int x, int y, int n)
+{
+	return 0;
+}
+
+static errr term_text_farm(int x, int y, int n, int a, const wchar_t *s)
+{
+	return 0;
+}
+
+static void term_data_link(void)
+{
+	term *t = &farm_term;
+
+	term_init(t, 80, 24, 256);
+
+	t->xtra_hook = term_xtra_farm;
+	t->curs_hook = term_curs_farm;
+	t->wipe_hook = term_wipe_farm;
+	t->text_hook = term_text_farm;
+
+	Term_activate(t);
+	angband_term[0] = t;
+}
+
+/**
+ * Quote a field for CSV if it needs it
+ */
+static void csv_field(FILE *fp, const char *s, bool last)
+{
+	if (strpbrk(s, ",\"\n")) {
+		fputc('"', fp);
+		for (; *s; s++) {
+			if (*s == '"') fputc('"', fp);
+			fputc(*s, fp);
+		}
+		fputc('"', fp);
+	} else {
+		fputs(s, fp);
+	}
+	fputc(last ? '\n' : ',', fp);
+}
+
+static void csv_write(FILE *fp, const struct farm_result *r)
+{
+	fprintf(fp, "%d,%lu,", r->run + 1, (unsigned long)r->seed);
+	csv_field(fp, r->race, false);
+	csv_field(fp, r->class, false);
+	fprintf(fp, "%d,%d,%ld,%lu,%.1f,%.1f,", r->clvl, r->max_depth,
+		(long)r->game_turns, (unsigned long)r->player_turns, r->secs,
+		(r->secs > 0) ? r->game_turns / r->secs : 0.0);
+	csv_field(fp, r->outcome, false);
+	csv_field(fp, r->cause, true);
+}
+
+#ifdef USE_STATS
+static int db_write(const struct farm_result *res, int n)
+{
+	sqlite3_stmt *stmt;
+	int err, i;
+
+	err = stats_db_exec("CREATE TABLE borg_runs(run INT PRIMARY KEY, "
+		"seed INT, race TEXT, class TEXT, clvl INT, max_depth INT, "
+		"game_turns INT, player_turns INT, seconds REAL, "
+		"outcome TEXT, cause TEXT);");
+	if (err) return err;
+
+	err = stats_db_stmt_prep(&stmt, "INSERT INTO borg_runs VALUES("
+		"?,?,?,?,?,?,?,?,?,?,?);");
+	if (err) return err;
+
+	for (i = 0; i < n; i++) {
+		const struct farm_result *r = &res[i];
+
+		err = stats_db_bind_ints(stmt, 2, 0, r->run + 1, r->seed);
+		if (err) return err;
+		err = sqlite3_bind_text(stmt, 3, r->race, -1, SQLITE_STATIC);
+		if (err) return err;
+		err = sqlite3_bind_text(stmt, 4, r->class, -1, SQLITE_STATIC);
+		if (err) return err;
+		err = stats_db_bind_ints(stmt, 4, 4, r->clvl, r->max_depth,
+			r->game_turns, r->player_turns);
+		if (err) return err;
+		err = sqlite3_bind_double(stmt, 9, r->secs);
+		if (err) return err;
+		err = sqlite3_bind_text(stmt, 10, r->outcome, -1,
+			SQLITE_STATIC);
+		if (err) return err;
+		err = sqlite3_bind_text(stmt, 11, r->cause, -1, SQLITE_STATIC);
+		if (err) return err;
+		STATS_DB_STEP_RESET(stmt)
+	}
+
+	STATS_DB_FINALIZE(stmt)
+	return SQLITE_OK;
+}
+#endif /* USE_STATS */
+
+/**
+ * Print totals over all runs, and the commonest causes of death
+ */
+static void farm_summary(const struct farm_result *res, int n)
+{
+	const char *causes[FARM_CAUSES_SHOWN];
+	int counts[FARM_CAUSES_SHOWN];
+	int i, j, n_causes = 0, deaths = 0, max_depth = 0;
+	double depth = 0, clvl = 0, turns = 0, secs = 0;
+
+	for (i = 0; i < n; i++) {
+		depth += res[i].max_depth;
+		clvl += res[i].clvl;
+		turns += res[i].game_turns;
+		secs += res[i].secs;
+		max_depth = MAX(max_depth, res[i].max_depth);
+		if (!streq(res[i].outcome, "died")) continue;
+
+		deaths++;
+		for (j = 0; j < n_causes; j++) {
+			if (streq(causes[j], res[i].cause)) break;
+		}
+		if (j < n_causes) {
+			counts[j]++;
+		} else if (n_causes < FARM_CAUSES_SHOWN) {
+			causes[n_causes] = res[i].cause;
+			counts[n_causes++] = 1;
+		}
+	}
+	if (!n) return;
+
+	printf("\nruns %d, deaths %d\n", n, deaths);
+	printf("mean max depth %.1f (deepest %d), mean clvl %.1f\n",
+		depth / n, max_depth, clvl / n);
+	printf("game turns per second %.1f\n", (secs > 0) ? turns / secs : 0.0);
+	if (!n_causes) return;
+
+	printf("\ncauses of death:\n");
+	for (i = 0; i < n_causes; i++) {
+		int best = i;
+
+		for (j = i + 1; j < n_causes; j++) {
+			if (counts[j] > counts[best]) best = j;
+		}
+		if (best != i) {
+			const char *c = causes[i];
+			int k = counts[i];
+
+			causes[i] = causes[best];
+			counts[i] = counts[best];
+			causes[best] = c;
+			counts[best] = k;
+		}
+		printf("%6d  %s\n", counts[i], causes[i]);
+	}
+}
+
+/**
+ * Start runs until there are enough going, collect them as they end, and
+ * report.  Only returns in a child, which then plays its run.
+ */
+static void farm_supervise(void)
+{
+	pid_t *pids = mem_zalloc(farm.jobs * sizeof(*pids));
+	int *fds = mem_zalloc(farm.jobs * sizeof(*fds));
+	int *runs = mem_zalloc(farm.jobs * sizeof(*runs));
+	struct farm_result *res = mem_zalloc(farm.runs * sizeof(*res));
+	int next = 0, active = 0, done = 0, i;
+	FILE *fp;
+
+	fp = fopen(farm.csv, "w");
+	if (!fp) quit_fmt("init-farm: cannot write '%s'", farm.csv);
+	fprintf(fp, "run,seed,race,class,clvl,max_depth,game_turns,"
+		"player_turns,seconds,turns_per_second,outcome,cause\n");
+
+	while (next < farm.runs || active) {
+		struct farm_result *r;
+		int status = 0;
+		ssize_t got = 0;
+		pid_t pid;
+
+		/* Fill the free slots */
+		for (i = 0; i < farm.jobs && next < farm.runs; i++) {
+			int pipefd[2];
+
+			if (pids[i]) continue;
+			if (pipe(pipefd) != 0) quit("init-farm: cannot make a pipe");
+			fflush(stdout);
+			fflush(fp);
+			pid = fork();
+			if (pid < 0) quit("init-farm: cannot fork");
+			if (pid == 0) {
+				int j;
+
+				for (j = 0; j < farm.jobs; j++) {
+					if (pids[j]) close(fds[j]);
+				}
+				close(pipefd[0]);
+				fclose(fp);
+				farm.run = next;
+				farm.fd = pipefd[1];
+				mem_free(res);
+				mem_free(runs);
+				mem_free(fds);
+				mem_free(pids);
+				if (farm.max_secs) alarm(farm.max_secs + FARM_GRACE);
+				return;
+			}
+			close(pipefd[1]);
+			pids[i] = pid;
+			fds[i] = pipefd[0];
+			runs[i] = next++;
+			active++;
+		}
+
+		/* Wait for one to end */
+		pid = waitpid(-1, &status, 0);
+		if (pid < 0) break;
+		for (i = 0; i < farm.jobs && pids[i] != pid; i++) ;
+		if (i == farm.jobs) continue;
+
+		r = &res[done];
+		while (got < (ssize_t)sizeof(*r)) {
+			ssize_t n = read(fds[i], (char *)r + got, sizeof(*r) - got);
+
+			if (n <= 0) break;
+			got += n;
+		}
+		if (got != (ssize_t)sizeof(*r)) {
+			memset(r, 0, sizeof(*r));
+			r->run = runs[i];
+			r->seed = farm.seed + runs[i];
+			my_strcpy(r->outcome, "crashed", sizeof(r->outcome));
+			if (WIFSIGNALED(status)) {
+				strnfmt(r->cause, sizeof(r->cause), "signal %d",
+					WTERMSIG(status));
+			}
+		}
+		close(fds[i]);
+		pids[i] = 0;
+		active--;
+		done++;
+
+		csv_write(fp, r);
+		fflush(fp);
+		printf("run %d: %s %s, clvl %d, depth %d, %s%s%s\n", r->run + 1,
+			r->race, r->class, r->clvl, r->max_depth, r->outcome,
+			r->cause[0] ? ": " : "", r->cause);
+	}
+	fclose(fp);
+
+#ifdef USE_STATS
+	if (stats_db_open()) {
+		if (db_write(res, done)) {
+			printf("init-farm: could not write the database\n");
+		}
+		stats_db_close();
+	} else {
+		printf("init-farm: could not make a database\n");
+	}
+#endif
+
+	farm_summary(res, done);
+	printf("\nwrote %s\n", farm.csv);
+
+	mem_free(res);
+	mem_free(runs);
+	mem_free(fds);
+	mem_free(pids);
+	quit(NULL);
+}
+
+const char help_farm[] =
+	"Borg farm mode, subopts\n"
+	"              -j count    Borgs to run at once (default 2)\n"
+	"              -r count    Runs in all (default 4)\n"
+	"              -s seed     Seed of the first run; run n uses seed+n\n"
+	"                          (default from the clock)\n"
+	"              -t turns    Stop a run after that many game turns\n"
+	"              -T secs     Stop a run after that many seconds\n"
+	"              -R race     Play only that race (default random)\n"
+	"              -C class    Play only that class (default random)\n"
+	"              -o fname    Write the CSV report to fname\n"
+	"                          (default borg-farm.csv)";
+
+errr init_farm(int argc, char *argv[])
+{
+	int i;
+
+	farm.jobs = 2;
+	farm.runs = 4;
+	farm.seed = (uint32_t)time(NULL);
+	farm.csv = "borg-farm.csv";
+
+	/* Skip over argv[0] */
+	for (i = 1; i < argc; i++) {
+		if (i + 1 < argc && streq(argv[i], "-j")) {
+			farm.jobs = atoi(argv[++i]);
+		} else if (i + 1 < argc && streq(argv[i], "-r")) {
+			farm.runs = atoi(argv[++i]);
+		} else if (i + 1 < argc && streq(argv[i], "-s")) {
+			farm.seed = (uint32_t)strtoul(argv[++i], NULL, 0);
+		} else if (i + 1 < argc && streq(argv[i], "-t")) {
+			farm.max_turns = atoi(argv[++i]);
+		} else if (i + 1 < argc && streq(argv[i], "-T")) {
+			farm.max_secs = atoi(argv[++i]);
+		} else if (i + 1 < argc && streq(argv[i], "-R")) {
+			farm.race = argv[++i];
+		} else if (i + 1 < argc && streq(argv[i], "-C")) {
+			farm.class = argv[++i];
+		} else if (i + 1 < argc && streq(argv[i], "-o")) {
+			farm.csv = argv[++i];
+		} else {
+			printf("init-farm: bad argument '%s'\n", argv[i]);
+			return 1;
+		}
+	}
+	farm.runs = MAX(1, farm.runs);
+	farm.jobs = MIN(MAX(1, farm.jobs), farm.runs);
+	farm.max_turns = MAX(0, farm.max_turns);
+	farm.max_secs = MAX(0, farm.max_secs);
+
+	farm_supervise();
+
+	/* Only a child gets here: give it a savefile of its own */
+	strnfmt(arg_name, sizeof(arg_name), "Farm%d", farm.run + 1);
+	arg_force_name = true;
+	savefile_set_name(arg_name, true, false);
+	if (file_exists(savefile)) file_delete(savefile);
+	farm.start_ns = farm_now();
+
+	term_data_link();
+
+	return 0;
+}
+
+#endif /* USE_FARM */
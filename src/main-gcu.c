@@ -127,8 +127,25 @@ typedef struct term_data {
 	term t;                 /* All term info */
 	rect_t r;
 	WINDOW *win;            /* Pointer to the curses window */
+	int attr;               /* Last wattrset() for win, or -1 if unknown */
 } term_data;
 
+/**
+ * Text from Term_text_gcu() not yet passed to curses.  Runs with the same
+ * attribute on a row are joined, across short stretches of unchanged cells,
+ * so each is one call; the characters are always in the term's screen.
+ */
+static struct {
+	term_data *td;          /* NULL if there's nothing pending */
+	int x, y, n, a;
+} text_run;
+
+/* Longest stretch of unchanged cells to redraw to join two runs */
+#define TEXT_RUN_GAP 4
+
+/* Whether there are refreshed windows doupdate() has yet to show */
+static bool update_pending = false;
+
 /* Max number of windows on screen */
 #define MAX_TERM_DATA 6
 
@@ -271,6 +288,82 @@ static void keymap_game_prepare(void) {
 }
 
 
+/**
+ * Set the attribute for a window, unless it is set already
+ */
+static void gcu_set_attr(term_data *td, int mode) {
+	if (td->attr != mode) {
+		wattrset(td->win, mode);
+		td->attr = mode;
+	}
+}
+
+
+/**
+ * Set the attribute for drawing text with the Angband attribute a
+ */
+static void gcu_text_attr(term_data *td, int a) {
+#ifdef A_COLOR
+	if (can_use_color) {
+
+		/* the lower 7 bits of the attribute indicate the fg/bg */
+		int attr = a & 127;
+
+		/* the high bit of the attribute indicates a reversed fg/bg */
+		bool reversed = a > 127;
+
+		int color;
+
+		/* Set bg and fg to the same color when drawing solid walls */
+		if (a / MULT_BG == BG_SAME) {
+			color = same_colortable[attr];
+		} else {
+			color = colortable[attr];
+		}
+
+		/* the following check for A_BRIGHT is to avoid #1813 */
+		int mode;
+		if (reversed && (color & A_BRIGHT))
+			mode = (color & ~A_BRIGHT) | A_BLINK | A_REVERSE;
+		else if (reversed)
+			mode = color | A_REVERSE;
+		else
+			mode = color | A_NORMAL;
+
+		gcu_set_attr(td, mode);
+	}
+#endif
+}
+
+
+/**
+ * Pass the pending text run, if any, to curses
+ */
+static void gcu_flush_text(void) {
+	term_data *td = text_run.td;
+
+	if (!td) return;
+	text_run.td = NULL;
+
+	gcu_text_attr(td, text_run.a);
+	mvwaddnwstr(td->win, text_run.y, text_run.x,
+		&td->t.scr->c[text_run.y][text_run.x], text_run.n);
+}
+
+
+/**
+ * Show what has been refreshed in all the windows with one doupdate(), so
+ * overlapping changes go to the terminal once
+ */
+static void gcu_update(void) {
+	gcu_flush_text();
+	if (update_pending) {
+		doupdate();
+		update_pending = false;
+	}
+}
+
+
 /**
  * Suspend/Resume
  */
@@ -279,6 +372,8 @@ static errr Term_xtra_gcu_alive(int v) {
 		/* Suspend */
 		int x, y;
 
+		gcu_update();
+
 		/* Go to normal keymap mode */
 		keymap_norm();
 
@@ -620,6 +715,9 @@ static void Term_nuke_gcu(term *t) {
 	int x, y;
 	term_data *td = (term_data *)(t->data);
 
+	/* Write out anything pending for the window */
+	if (text_run.td == td) gcu_flush_text();
+
 	/* Delete this window */
 	delwin(td->win);
 
@@ -793,15 +891,18 @@ static errr Term_xtra_gcu_event(int v) {
 		/* Wait for a keypress; use halfdelay(1) so if the user takes more */
 		/* than 0.2 seconds we get a chance to do updates. */
 		halfdelay(2);
+		gcu_update();
 		i = getch();
 		while (i == ERR) {
 			if (terms_disconnecting) return 1;
 			idle_update();
+			gcu_update();
 			i = getch();
 		}
 		cbreak();
 	} else {
 		/* Do not wait for it */
+		gcu_update();
 		nodelay(stdscr, true);
 
 		/* Check for keypresses */
@@ -1056,6 +1157,8 @@ static void handle_extended_color_tables(void) {
 static errr Term_xtra_gcu(int n, int v) {
 	term_data *td = (term_data *)(Term->data);
 
+	gcu_flush_text();
+
 	/* Analyze the request */
 	switch (n) {
 		/* Clear screen */
@@ -1066,8 +1169,11 @@ static errr Term_xtra_gcu(int n, int v) {
 		 * it may flash the screen */
 		case TERM_XTRA_NOISE: beep(); return 0;
 
-		/* Flush the Curses buffer */
-		case TERM_XTRA_FRESH: wrefresh(td->win); return 0;
+		/* Mark the window for the next doupdate(), see gcu_update() */
+		case TERM_XTRA_FRESH:
+			wnoutrefresh(td->win);
+			update_pending = true;
+			return 0;
 
 #ifdef USE_CURS_SET
 		/* Change the cursor visibility */
@@ -1084,7 +1190,10 @@ static errr Term_xtra_gcu(int n, int v) {
 		case TERM_XTRA_FLUSH: while (!Term_xtra_gcu_event(false)); return 0;
 
 		/* Delay */
-		case TERM_XTRA_DELAY: if (v > 0) usleep(1000 * v); return 0;
+		case TERM_XTRA_DELAY:
+			gcu_update();
+			if (v > 0) usleep(1000 * v);
+			return 0;
 
 		/* React to events */
 		case TERM_XTRA_REACT: handle_extended_color_tables(); return 0;
@@ -1100,6 +1209,7 @@ static errr Term_xtra_gcu(int n, int v) {
  */
 static errr Term_curs_gcu(int x, int y) {
 	term_data *td = (term_data *)(Term->data);
+	gcu_flush_text();
 	wmove(td->win, y, x);
 	return 0;
 }
@@ -1112,6 +1222,7 @@ static errr Term_curs_gcu(int x, int y) {
 static errr Term_wipe_gcu(int x, int y, int n) {
 	term_data *td = (term_data *)(Term->data);
 
+	gcu_flush_text();
 	wmove(td->win, y, x);
 
 	if (x + n >= td->t.wid) {
@@ -1120,12 +1231,9 @@ static errr Term_wipe_gcu(int x, int y, int n) {
 	} else {
 		/* Clear some characters */
 		if (can_use_color) {
-			wattrset(td->win, colortable[COLOUR_DARK] | A_NORMAL);
+			gcu_set_attr(td, colortable[COLOUR_DARK] | A_NORMAL);
 		}
 		whline(td->win, ' ', n);
-		if (can_use_color) {
-			wattrset(td->win, A_NORMAL);
-		}
 	}
 
 	return 0;
@@ -1134,45 +1242,43 @@ static errr Term_wipe_gcu(int x, int y, int n) {
 
 /**
  * Place some text on the screen using an attribute
+ *
+ * The text is held back in text_run so it can be joined with what comes
+ * next; any other request to the term writes it out first.
  */
 static errr Term_text_gcu(int x, int y, int n, int a, const wchar_t *s) {
 	term_data *td = (term_data *)(Term->data);
 
-#ifdef A_COLOR
-	if (can_use_color) {
-
-		/* the lower 7 bits of the attribute indicate the fg/bg */
-		int attr = a & 127;
-
-		/* the high bit of the attribute indicates a reversed fg/bg */
-		bool reversed = a > 127;
-
-		int color;
+	if (text_run.td == td && text_run.y == y && text_run.a == a
+			&& x >= text_run.x + text_run.n
+			&& x - (text_run.x + text_run.n) <= TEXT_RUN_GAP) {
+		const int *gap_a = td->t.scr->a[y];
+		int gx;
 
-		/* Set bg and fg to the same color when drawing solid walls */
-		if (a / MULT_BG == BG_SAME) {
-			color = same_colortable[attr];
-		} else {
-			color = colortable[attr];
+		/* The cells in between must look the same */
+		for (gx = text_run.x + text_run.n; gx < x; gx++) {
+			if (gap_a[gx] != a) break;
+		}
+		if (gx == x && s == &td->t.scr->c[y][x]) {
+			text_run.n = x + n - text_run.x;
+			return 0;
 		}
+	}
 
-		/* the following check for A_BRIGHT is to avoid #1813 */
-		int mode;
-		if (reversed && (color & A_BRIGHT))
-			mode = (color & ~A_BRIGHT) | A_BLINK | A_REVERSE;
-		else if (reversed)
-			mode = color | A_REVERSE;
-		else
-			mode = color | A_NORMAL;
+	gcu_flush_text();
 
-		wattrset(td->win, mode);
+	/* Only text straight from the screen can wait */
+	if (s != &td->t.scr->c[y][x]) {
+		gcu_text_attr(td, a);
 		mvwaddnwstr(td->win, y, x, s, n);
-		wattrset(td->win, A_NORMAL);
 		return 0;
 	}
-#endif
 
-	mvwaddnwstr(td->win, y, x, s, n);
+	text_run.td = td;
+	text_run.x = x;
+	text_run.y = y;
+	text_run.n = n;
+	text_run.a = a;
 	return 0;
 }
 
@@ -1191,6 +1297,7 @@ static errr term_data_init_gcu(term_data *td, int rows, int cols, int y, int x)
 	/* Check for failure */
 	if (!td->win)
 		quit("Failed to setup curses window.");
+	td->attr = -1;
 
 	/* Initialize the term */
 	term_init(t, cols, rows, 256);
@@ -189,14 +189,45 @@ static const char g_ascii_codepoints_for_cache[] =
 	" !\"#$%&'()*+,-./0123456789:;<=>?"
 	"@ABCDEFGHIJKLMNOPQRSTUVWXYZ[\\]^_"
 	"`abcdefghijklmnopqrstuvwxyz{|}~\x7f";
-/* Simple font cache. Only for ascii (which is like 99.99% (?) of what the game
- * displays, anyway) */
+/* Simple font cache. Ascii (which is like 99.99% (?) of what the game
+ * displays, anyway) is rendered up front; other glyphs go into an atlas
+ * in the rows below that, see font_atlas_get() */
 #define ASCII_CACHE_SIZE \
 		(N_ELEMENTS(g_ascii_codepoints_for_cache) - 1)
+/* glyphs per row of the cache texture */
+#define FONT_CACHE_COLS 16
+/* the atlas starts with room for this many glyphs and doubles as needed... */
+#define FONT_ATLAS_MIN_GLYPHS 64
+/* ...up to this many; after that, the least recently drawn glyph is evicted */
+#define FONT_ATLAS_MAX_GLYPHS 2048
+#define FONT_ATLAS_NONE (-1)
+struct font_atlas_cell {
+	uint32_t codepoint;
+	/* neighbours in the recently drawn list */
+	int newer;
+	int older;
+	/* next cell in the same hash bucket */
+	int chain;
+};
 struct font_cache {
 	SDL_Texture *texture;
 	/* it wastes some space... so what? */
 	SDL_Rect rects[ASCII_CACHE_SIZE];
+
+	/* one opaque white texel, for drawing fills */
+	SDL_Rect solid;
+
+	/* atlas of other glyphs */
+	struct font_atlas_cell *cells;
+	int buckets[FONT_ATLAS_MAX_GLYPHS];
+	/* texture row holding the first cell */
+	int first_row;
+	/* cells the texture has room for */
+	int capacity;
+	/* cells in use */
+	int used;
+	int newest;
+	int oldest;
 };
 /* 0 is also a valid codepoint, of course... that's just for finding bugs */
 #define IS_CACHED_ASCII_CODEPOINT(c) \
@@ -335,6 +366,32 @@ struct wallpaper {
 	enum wallpaper_mode mode;
 };
 
+/** a glyph, tile or fill waiting in a draw_batch */
+struct draw_quad {
+	/* NULL only for a translucent fill */
+	SDL_Texture *texture;
+	/* for a fill, the solid texel to draw it with */
+	SDL_Rect src;
+	SDL_Rect dst;
+	SDL_Color color;
+	bool fill;
+};
+
+/** drawing queued for one render target, see flush_draw_batch() */
+struct draw_batch {
+	SDL_Texture *target;
+	struct draw_quad *quads;
+	size_t n;
+	size_t alloc;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	SDL_Vertex *vertices;
+	int *indices;
+	size_t vertex_alloc;
+	/* SDL_RenderGeometry() failed once; don't try it again */
+	bool no_geometry;
+#endif
+};
+
 /** struct sdlpui_window is a real window on screen, it has one or more
  * subwindows (terms) in it */
 struct sdlpui_window {
@@ -374,6 +431,8 @@ struct sdlpui_window {
 
 	SDL_Window *window;
 	SDL_Renderer *renderer;
+	/** drawing to subwindows not yet passed to the renderer */
+	struct draw_batch *batch;
 	/** The font to use for this window's dialogs and menus */
 	struct font *dialog_font;
 	/** The status bar (i.e. menu bar) for the window */
@@ -535,6 +594,8 @@ static bool is_ok_col_row(const struct subwindow *subwindow,
 static void resize_rect(SDL_Rect *rect,
 		int left, int top, int right, int bottom);
 static void crop_rects(SDL_Rect *src, SDL_Rect *dst);
+static SDL_Texture *make_subwindow_texture(const struct sdlpui_window *window,
+		int w, int h);
 static bool is_point_in_rect(int x, int y, const SDL_Rect *rect);
 static bool is_close_to(int a, int b, unsigned range);
 static void handle_window_closed(struct my_app *a,
@@ -774,9 +835,192 @@ static void log_window_details(int my_index, SDL_Window *w, SDL_Renderer *r)
 	}
 }
 
+/**
+ * Drawing to a subwindow's texture is queued rather than done at once, so a
+ * whole refresh of the subwindow can go to the renderer in a few calls to
+ * SDL_RenderGeometry() instead of one SDL_RenderCopy() and colour change per
+ * glyph or tile.  Consecutive quads from the same texture share one call.
+ * Anything that draws directly (render_clear(), render_fill_rect(), ...)
+ * flushes the queue first, and so does term_xtra_fresh(), so the queue never
+ * outlives a Term_fresh().  Without SDL_RenderGeometry(), or if it fails, the
+ * quads are drawn one at a time as before.
+ */
+static void flush_draw_batch(const struct sdlpui_window *window)
+{
+	struct draw_batch *batch = window->batch;
+
+	if (batch == NULL || batch->n == 0) {
+		return;
+	}
+
+	SDL_Texture *old_target = SDL_GetRenderTarget(window->renderer);
+	size_t i = 0;
+
+	SDL_SetRenderTarget(window->renderer, batch->target);
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	while (i < batch->n && !batch->no_geometry) {
+		SDL_Texture *texture = batch->quads[i].texture;
+		size_t end = i + 1;
+		int tex_w = 1, tex_h = 1;
+
+		while (end < batch->n && batch->quads[end].texture == texture) {
+			++end;
+		}
+		if ((end - i) * 4 > batch->vertex_alloc) {
+			batch->vertex_alloc = (end - i) * 4;
+			batch->vertices = mem_realloc(batch->vertices,
+				batch->vertex_alloc * sizeof(*batch->vertices));
+			batch->indices = mem_realloc(batch->indices,
+				(batch->vertex_alloc / 4) * 6
+				* sizeof(*batch->indices));
+		}
+		if (texture != NULL) {
+			SDL_QueryTexture(texture, NULL, NULL, &tex_w, &tex_h);
+			/* the colour comes with the vertices */
+			SDL_SetTextureColorMod(texture, 0xFF, 0xFF, 0xFF);
+		}
+
+		for (size_t j = i; j < end; j++) {
+			const struct draw_quad *q = &batch->quads[j];
+			SDL_Vertex *v = &batch->vertices[(j - i) * 4];
+			int *ind = &batch->indices[(j - i) * 6];
+			float u0, v0, u1, v1;
+			int k = (int)(j - i) * 4;
+
+			if (q->fill) {
+				/* sample the middle of the solid texel */
+				u0 = u1 = (q->src.x + 0.5f) / tex_w;
+				v0 = v1 = (q->src.y + 0.5f) / tex_h;
+			} else {
+				u0 = (float)q->src.x / tex_w;
+				v0 = (float)q->src.y / tex_h;
+				u1 = (float)(q->src.x + q->src.w) / tex_w;
+				v1 = (float)(q->src.y + q->src.h) / tex_h;
+			}
+			v[0].position.x = (float)q->dst.x;
+			v[0].position.y = (float)q->dst.y;
+			v[0].tex_coord.x = u0;
+			v[0].tex_coord.y = v0;
+			v[1].position.x = (float)(q->dst.x + q->dst.w);
+			v[1].position.y = (float)q->dst.y;
+			v[1].tex_coord.x = u1;
+			v[1].tex_coord.y = v0;
+			v[2].position.x = (float)(q->dst.x + q->dst.w);
+			v[2].position.y = (float)(q->dst.y + q->dst.h);
+			v[2].tex_coord.x = u1;
+			v[2].tex_coord.y = v1;
+			v[3].position.x = (float)q->dst.x;
+			v[3].position.y = (float)(q->dst.y + q->dst.h);
+			v[3].tex_coord.x = u0;
+			v[3].tex_coord.y = v1;
+			v[0].color = v[1].color = v[2].color = v[3].color = q->color;
+
+			ind[0] = k;
+			ind[1] = k + 1;
+			ind[2] = k + 2;
+			ind[3] = k;
+			ind[4] = k + 2;
+			ind[5] = k + 3;
+		}
+
+		if (SDL_RenderGeometry(window->renderer, texture,
+				batch->vertices, (int)(end - i) * 4,
+				batch->indices, (int)(end - i) * 6) != 0) {
+			/* draw this run and all later ones the old way */
+			batch->no_geometry = true;
+			break;
+		}
+		i = end;
+	}
+#endif
+
+	for (; i < batch->n; i++) {
+		const struct draw_quad *q = &batch->quads[i];
+
+		if (q->fill) {
+			SDL_SetRenderDrawColor(window->renderer,
+				q->color.r, q->color.g, q->color.b, q->color.a);
+			SDL_RenderFillRect(window->renderer, &q->dst);
+		} else {
+			SDL_SetTextureColorMod(q->texture,
+				q->color.r, q->color.g, q->color.b);
+			SDL_RenderCopy(window->renderer, q->texture, &q->src,
+				&q->dst);
+		}
+	}
+
+	batch->n = 0;
+	SDL_SetRenderTarget(window->renderer, old_target);
+}
+
+static struct draw_quad *new_draw_quad(const struct sdlpui_window *window,
+		SDL_Texture *target)
+{
+	struct draw_batch *batch = window->batch;
+
+	if (batch->n > 0 && batch->target != target) {
+		flush_draw_batch(window);
+	}
+	batch->target = target;
+	if (batch->n == batch->alloc) {
+		batch->alloc = (batch->alloc) ? 2 * batch->alloc : 256;
+		batch->quads = mem_realloc(batch->quads,
+			batch->alloc * sizeof(*batch->quads));
+	}
+	return &batch->quads[batch->n++];
+}
+
+/** queues a copy of src in texture to dst in target, coloured with color */
+static void queue_copy(const struct sdlpui_window *window,
+		SDL_Texture *target, SDL_Texture *texture,
+		const SDL_Rect *src, const SDL_Rect *dst, const SDL_Color *color)
+{
+	struct draw_quad *q = new_draw_quad(window, target);
+
+	q->texture = texture;
+	q->src = *src;
+	q->dst = *dst;
+	q->color = *color;
+	/* SDL_RenderCopy() never had an alpha mod, so neither do the vertices */
+	q->color.a = 0xFF;
+	q->fill = false;
+}
+
+/** queues what render_fill_rect() does; opaque fills are drawn with the
+ * font's solid texel so they can go in the same call as its glyphs */
+static void queue_fill(const struct sdlpui_window *window,
+		SDL_Texture *target, const struct font *font,
+		const SDL_Rect *rect, const SDL_Color *color)
+{
+	struct draw_quad *q = new_draw_quad(window, target);
+
+	if (color->a == 0xFF) {
+		q->texture = font->cache.texture;
+		q->src = font->cache.solid;
+	} else {
+		/* with no texture, geometry replaces the alpha, as fills do */
+		q->texture = NULL;
+	}
+	q->dst = *rect;
+	q->color = *color;
+	q->fill = true;
+}
+
+static void free_draw_batch(struct draw_batch *batch)
+{
+	mem_free(batch->quads);
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+	mem_free(batch->vertices);
+	mem_free(batch->indices);
+#endif
+	mem_free(batch);
+}
+
 static void render_clear(const struct sdlpui_window *window,
 		SDL_Texture *texture, const SDL_Color *color)
 {
+	flush_draw_batch(window);
 	SDL_SetRenderTarget(window->renderer, texture);
 	SDL_SetRenderDrawColor(window->renderer,
 			color->r, color->g, color->b, color->a);
@@ -846,6 +1090,7 @@ static void render_background(const struct sdlpui_window *window)
 static void render_outline_rect(const struct sdlpui_window *window,
 		SDL_Texture *texture, const SDL_Rect *rect, const SDL_Color *color)
 {
+	flush_draw_batch(window);
 	SDL_SetRenderTarget(window->renderer, texture);
 	SDL_SetRenderDrawColor(window->renderer,
 			color->r, color->g, color->b, color->a);
@@ -866,6 +1111,7 @@ static void render_outline_rect_width(const struct sdlpui_window *window,
 static void render_fill_rect(const struct sdlpui_window *window,
 		SDL_Texture *texture, const SDL_Rect *rect, const SDL_Color *color)
 {
+	flush_draw_batch(window);
 	SDL_SetRenderTarget(window->renderer, texture);
 	SDL_SetRenderDrawColor(window->renderer,
 			color->r, color->g, color->b, color->a);
@@ -1042,10 +1288,175 @@ static void redraw_all_windows(struct my_app *a, bool dirty)
 	}
 }
 
-/** this function is typically called in a loop, so for efficiency it doesn't
- * SetRenderTarget; caller must do it (but it does SetTextureColorMod) */
+static SDL_Rect font_atlas_rect(const struct font *font, int cell)
+{
+	SDL_Rect rect = {
+		(cell % FONT_CACHE_COLS) * font->ttf.glyph.w,
+		(font->cache.first_row + cell / FONT_CACHE_COLS) * font->ttf.glyph.h,
+		font->ttf.glyph.w,
+		font->ttf.glyph.h
+	};
+
+	return rect;
+}
+
+static int font_atlas_bucket(uint32_t codepoint)
+{
+	return (int)((codepoint * 2654435761u) % FONT_ATLAS_MAX_GLYPHS);
+}
+
+static void font_atlas_unlink(struct font_cache *cache, int cell)
+{
+	struct font_atlas_cell *c = &cache->cells[cell];
+
+	if (c->newer == FONT_ATLAS_NONE) {
+		cache->newest = c->older;
+	} else {
+		cache->cells[c->newer].older = c->older;
+	}
+	if (c->older == FONT_ATLAS_NONE) {
+		cache->oldest = c->newer;
+	} else {
+		cache->cells[c->older].newer = c->newer;
+	}
+}
+
+static void font_atlas_push_newest(struct font_cache *cache, int cell)
+{
+	struct font_atlas_cell *c = &cache->cells[cell];
+
+	c->newer = FONT_ATLAS_NONE;
+	c->older = cache->newest;
+	if (cache->newest == FONT_ATLAS_NONE) {
+		cache->oldest = cell;
+	} else {
+		cache->cells[cache->newest].newer = cell;
+	}
+	cache->newest = cell;
+}
+
+static void font_atlas_unhash(struct font_cache *cache, int cell)
+{
+	int *link = &cache->buckets[font_atlas_bucket(cache->cells[cell].codepoint)];
+
+	while (*link != cell) {
+		assert(*link != FONT_ATLAS_NONE);
+		link = &cache->cells[*link].chain;
+	}
+	*link = cache->cells[cell].chain;
+}
+
+/** makes the cache texture taller to double the atlas; returns false if the
+ * atlas is as big as it may get */
+static bool font_atlas_grow(const struct sdlpui_window *window,
+		struct font *font)
+{
+	struct font_cache *cache = &font->cache;
+	int capacity = MIN(cache->capacity * 2, FONT_ATLAS_MAX_GLYPHS);
+	int rows = cache->first_row
+		+ (capacity + FONT_CACHE_COLS - 1) / FONT_CACHE_COLS;
+	SDL_RendererInfo info;
+	int old_w, old_h;
+
+	if (capacity <= cache->capacity) {
+		return false;
+	}
+	if (SDL_GetRendererInfo(window->renderer, &info) == 0
+			&& info.max_texture_height > 0
+			&& rows * font->ttf.glyph.h > info.max_texture_height) {
+		return false;
+	}
+
+	SDL_Texture *texture = make_subwindow_texture(window,
+		FONT_CACHE_COLS * font->ttf.glyph.w, rows * font->ttf.glyph.h);
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0};
+	render_clear(window, texture, &white);
+
+	/* copy the glyphs so far as they are, alpha included */
+	SDL_QueryTexture(cache->texture, NULL, NULL, &old_w, &old_h);
+	SDL_Rect rect = {0, 0, old_w, old_h};
+	SDL_SetTextureBlendMode(cache->texture, SDL_BLENDMODE_NONE);
+	SDL_SetTextureColorMod(cache->texture, 0xFF, 0xFF, 0xFF);
+	SDL_RenderCopy(window->renderer, cache->texture, &rect, &rect);
+	SDL_DestroyTexture(cache->texture);
+
+	cache->texture = texture;
+	cache->cells = mem_realloc(cache->cells,
+		capacity * sizeof(*cache->cells));
+	cache->capacity = capacity;
+
+	return true;
+}
+
+/** finds the glyph for a codepoint outside the ascii cache, rendering it into
+ * the atlas first if it is not already there; rendering changes the render
+ * target, so it is set back to dst_texture afterwards */
+static bool font_atlas_get(const struct sdlpui_window *window,
+		struct font *font, SDL_Texture *dst_texture,
+		uint32_t codepoint, SDL_Rect *rect)
+{
+	struct font_cache *cache = &font->cache;
+	int bucket = font_atlas_bucket(codepoint);
+	int cell;
+
+	for (cell = cache->buckets[bucket];
+			cell != FONT_ATLAS_NONE;
+			cell = cache->cells[cell].chain) {
+		if (cache->cells[cell].codepoint == codepoint) {
+			font_atlas_unlink(cache, cell);
+			font_atlas_push_newest(cache, cell);
+			*rect = font_atlas_rect(font, cell);
+			return true;
+		}
+	}
+
+	/* we render glyphs in white and color them when copying */
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+	SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
+			(Uint16) codepoint, white);
+	if (surface == NULL) {
+		return false;
+	}
+	SDL_Texture *texture = SDL_CreateTextureFromSurface(window->renderer, surface);
+	if (texture == NULL) {
+		SDL_FreeSurface(surface);
+		return false;
+	}
+
+	/* take a free cell, or make more, or give up the stalest one */
+	if (cache->used < cache->capacity || font_atlas_grow(window, font)) {
+		cell = cache->used++;
+	} else {
+		cell = cache->oldest;
+		font_atlas_unlink(cache, cell);
+		font_atlas_unhash(cache, cell);
+	}
+	cache->cells[cell].codepoint = codepoint;
+	cache->cells[cell].chain = cache->buckets[bucket];
+	cache->buckets[bucket] = cell;
+	font_atlas_push_newest(cache, cell);
+
+	*rect = font_atlas_rect(font, cell);
+	SDL_Color clear = {0xFF, 0xFF, 0xFF, 0};
+	render_fill_rect(window, cache->texture, rect, &clear);
+
+	SDL_Rect src = {0, 0, surface->w, surface->h};
+	SDL_Rect dst = *rect;
+
+	crop_rects(&src, &dst);
+
+	SDL_RenderCopy(window->renderer, texture, &src, &dst);
+	SDL_SetRenderTarget(window->renderer, dst_texture);
+
+	SDL_FreeSurface(surface);
+	SDL_DestroyTexture(texture);
+
+	return true;
+}
+
+/** queues the glyph for dst_texture; it is drawn by flush_draw_batch() */
 static void render_glyph_mono(const struct sdlpui_window *window,
-		const struct font *font, SDL_Texture *dst_texture,
+		struct font *font, SDL_Texture *dst_texture,
 		int x, int y, const SDL_Color *fg, uint32_t codepoint)
 {
 	if (codepoint == ' ') {
@@ -1059,28 +1470,17 @@ static void render_glyph_mono(const struct sdlpui_window *window,
 
 		crop_rects(&src, &dst);
 
-		SDL_SetTextureColorMod(font->cache.texture, fg->r, fg->g, fg->b);
-
-		SDL_RenderCopy(window->renderer,
-				font->cache.texture, &font->cache.rects[codepoint], &dst);
+		queue_copy(window, dst_texture, font->cache.texture,
+				&font->cache.rects[codepoint], &dst, fg);
 	} else {
-		SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
-				(Uint16) codepoint, *fg);
-		if (surface == NULL) {
+		SDL_Rect src;
+
+		if (!font_atlas_get(window, font, dst_texture, codepoint, &src)) {
 			return;
 		}
 
-		SDL_Texture *texture = SDL_CreateTextureFromSurface(window->renderer, surface);
-		assert(texture != NULL);
-
-		SDL_Rect src = {0, 0, surface->w, surface->h};
-
-		crop_rects(&src, &dst);
-
-		SDL_RenderCopy(window->renderer, texture, &src, &dst);
-
-		SDL_FreeSurface(surface);
-		SDL_DestroyTexture(texture);
+		queue_copy(window, dst_texture, font->cache.texture,
+				&src, &dst, fg);
 	}
 }
 
@@ -1138,14 +1538,14 @@ static void render_grid_cell_text(const struct subwindow *subwindow,
 		subwindow->font_height
 	};
 
-	render_fill_rect(subwindow->window, texture, &rect, &bg);
+	queue_fill(subwindow->window, texture, subwindow->font, &rect, &bg);
 	render_glyph_mono(subwindow->window,
 			subwindow->font, texture, rect.x, rect.y, &fg, (uint32_t) c);
 }
 
-/** does not SetRenderTarget */
+/** queues the tile for texture */
 static void render_tile_rect_scaled(const struct subwindow *subwindow,
-		int col, int row, SDL_Rect dst, int a, int c)
+		SDL_Texture *texture, int col, int row, SDL_Rect dst, int a, int c)
 {
 	struct graphics *graphics = &subwindow->window->graphics;
 
@@ -1167,15 +1567,14 @@ static void render_tile_rect_scaled(const struct subwindow *subwindow,
 		src.h *= 2;
 	}
 
-	SDL_RenderCopy(subwindow->window->renderer,
-			graphics->texture, &src, &dst);
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+	queue_copy(subwindow->window, texture, graphics->texture, &src, &dst,
+			&white);
 }
 
-static void render_tile_font_scaled(const struct subwindow *subwindow,
-		int col, int row, int a, int c, bool fill, int dhrclip)
+static SDL_Rect tile_font_rect(const struct subwindow *subwindow,
+		int col, int row)
 {
-	struct graphics *graphics = &subwindow->window->graphics;
-
 	SDL_Rect dst = {
 		subwindow->inner_rect.x + col * subwindow->font_width,
 		subwindow->inner_rect.y + row * subwindow->font_height,
@@ -1183,14 +1582,31 @@ static void render_tile_font_scaled(const struct subwindow *subwindow,
 		subwindow->font_height * tile_height
 	};
 
+	return dst;
+}
+
+static void render_tile_font_fill(const struct subwindow *subwindow,
+		int col, int row)
+{
+	SDL_Rect dst = tile_font_rect(subwindow, col, row);
+
+	queue_fill(subwindow->window, subwindow->texture, subwindow->font,
+			&dst, &subwindow->color);
+}
+
+static void render_tile_font_scaled(const struct subwindow *subwindow,
+		int col, int row, int a, int c, bool fill, int dhrclip)
+{
+	struct graphics *graphics = &subwindow->window->graphics;
+
+	SDL_Rect dst = tile_font_rect(subwindow, col, row);
+
 	if (fill) {
-		render_fill_rect(subwindow->window, subwindow->texture, &dst, &subwindow->color);
+		render_tile_font_fill(subwindow, col, row);
 	}
 
 	SDL_Rect src = {0, 0, graphics->tile_pixel_w, graphics->tile_pixel_h};
 
-	SDL_SetRenderTarget(subwindow->window->renderer, subwindow->texture);
-
 	int src_row = a & 0x7f;
 	int src_col = c & 0x7f;
 
@@ -1206,13 +1622,11 @@ static void render_tile_font_scaled(const struct subwindow *subwindow,
 		dst.y -= dst.h;
 		dst.h *= 2;
 		src.h *= 2;
-
-		SDL_RenderCopy(subwindow->window->renderer,
-				graphics->texture, &src, &dst);
-	} else {
-		SDL_RenderCopy(subwindow->window->renderer,
-				graphics->texture, &src, &dst);
 	}
+
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0xFF};
+	queue_copy(subwindow->window, subwindow->texture, graphics->texture,
+			&src, &dst, &white);
 }
 
 static void render_grid_cell_tile(const struct subwindow *subwindow,
@@ -1227,15 +1641,13 @@ static void render_grid_cell_tile(const struct subwindow *subwindow,
 	map_info(loc(x, y), &grid_data);
 	grid_data_as_text(&grid_data, &a, &c, &ta, &tc);
 
-	SDL_SetRenderTarget(subwindow->window->renderer, texture);
-
-	render_tile_rect_scaled(subwindow, x, y, tile, ta, tc);
+	render_tile_rect_scaled(subwindow, texture, x, y, tile, ta, tc);
 
 	if (a == ta && c == tc) {
 		return;
 	}
 
-	render_tile_rect_scaled(subwindow, x, y, tile, a, c);
+	render_tile_rect_scaled(subwindow, texture, x, y, tile, a, c);
 }
 
 static void clear_all_borders(struct sdlpui_window *window)
@@ -4780,6 +5192,9 @@ static errr term_xtra_fresh(void)
 	struct subwindow *subwindow = Term->data;
 	assert(subwindow != NULL);
 
+	/* whether or not the window is redrawn now, finish this term's drawing */
+	flush_draw_batch(subwindow->window);
+
 	if (!subwindow->window->d_mouse && !subwindow->window->d_key) {
 		try_redraw_window(subwindow->window);
 	}
@@ -4860,7 +5275,8 @@ static errr term_wipe_hook(int col, int row, int n)
 		subwindow->font_height
 	};
 
-	render_fill_rect(subwindow->window, subwindow->texture, &rect, &subwindow->color);
+	queue_fill(subwindow->window, subwindow->texture, subwindow->font,
+			&rect, &subwindow->color);
 
 	subwindow->window->dirty = true;
 
@@ -4900,7 +5316,8 @@ static errr term_text_hook(int col, int row, int n, int a, const wchar_t *s)
 		subwindow->font_height
 	};
 
-	render_fill_rect(subwindow->window, subwindow->texture, &rect, &bg);
+	queue_fill(subwindow->window, subwindow->texture, subwindow->font,
+			&rect, &bg);
 
 	rect.w = subwindow->font_width;
 	for (int i = 0; i < n; i++) {
@@ -4942,8 +5359,20 @@ static errr term_pict_hook(int col, int row, int n,
 		dhrclip = 0;
 	}
 
+	/*
+	 * With one cell per tile, no fill overlaps another cell's tiles, so
+	 * doing the fills first lets the tiles go in one batch.
+	 */
+	bool fills_first = (tile_width == 1 && tile_height == 1);
+
+	if (fills_first) {
+		for (int i = 0; i < n; i++) {
+			render_tile_font_fill(subwindow, col + i, row);
+		}
+	}
+
 	for (int i = 0; i < n; i++) {
-		render_tile_font_scaled(subwindow, col + i, row, tap[i], tcp[i], true, dhrclip);
+		render_tile_font_scaled(subwindow, col + i, row, tap[i], tcp[i], !fills_first, dhrclip);
 
 		if (tap[i] == ap[i] && tcp[i] == cp[i]) {
 			continue;
@@ -5486,11 +5915,26 @@ static void make_font_cache(const struct sdlpui_window *window,
 	 * Limit the horizontal size of the texture for the cached font to
 	 * avoid bumping into limits in the renderer.
 	 */
-	const size_t ncol = 16;
+	const size_t ncol = FONT_CACHE_COLS;
+	const int ascii_rows = (int)((ASCII_CACHE_SIZE + (ncol - 1)) / ncol);
+
+	/* Start the atlas for other glyphs empty, with a little room */
+	font->cache.first_row = ascii_rows;
+	font->cache.capacity = FONT_ATLAS_MIN_GLYPHS;
+	font->cache.used = 0;
+	font->cache.newest = FONT_ATLAS_NONE;
+	font->cache.oldest = FONT_ATLAS_NONE;
+	for (size_t i = 0; i < N_ELEMENTS(font->cache.buckets); i++) {
+		font->cache.buckets[i] = FONT_ATLAS_NONE;
+	}
+	mem_free(font->cache.cells);
+	font->cache.cells = mem_alloc(font->cache.capacity
+		* sizeof(*font->cache.cells));
 
 	font->cache.texture = make_subwindow_texture(window,
 		(int)ncol * glyph_w,
-		(int)((ASCII_CACHE_SIZE + (ncol - 1)) / ncol) * glyph_h);
+		(ascii_rows + (FONT_ATLAS_MIN_GLYPHS + (int)(ncol - 1))
+		/ (int)ncol) * glyph_h);
 	assert(font->cache.texture != NULL);
 		
 	/* fill texture with white transparent pixels */
@@ -5535,6 +5979,17 @@ static void make_font_cache(const struct sdlpui_window *window,
 			++irow;
 		}
 	}
+
+	/*
+	 * The first glyph is never drawn (see IS_CACHED_ASCII_CODEPOINT()),
+	 * so its cell is made solid white for queue_fill() to sample.
+	 */
+	render_fill_rect(window, font->cache.texture, &font->cache.rects[0],
+		&white);
+	font->cache.solid.x = font->cache.rects[0].x + font->cache.rects[0].w / 2;
+	font->cache.solid.y = font->cache.rects[0].y + font->cache.rects[0].h / 2;
+	font->cache.solid.w = 1;
+	font->cache.solid.h = 1;
 }
 
 static struct font *make_font(const struct sdlpui_window *window,
@@ -5554,6 +6009,7 @@ static struct font *make_font(const struct sdlpui_window *window,
 	font->size = size;
 
 	font->cache.texture = NULL;
+	font->cache.cells = NULL;
 
 	load_font(font);
 	make_font_cache(window, font);
@@ -5627,6 +6083,7 @@ static void free_font(struct font *font)
 	if (font->cache.texture != NULL) {
 		SDL_DestroyTexture(font->cache.texture);
 	}
+	mem_free(font->cache.cells);
 
 	mem_free(font);
 }
@@ -6245,6 +6702,7 @@ static void start_window(struct sdlpui_window *window)
 		quit_fmt("cannot create renderer for window %u: %s",
 				window->index, SDL_GetError());
 	}
+	window->batch = mem_zalloc(sizeof(*window->batch));
 
 	SDL_RendererInfo info;
 	if (SDL_GetRendererInfo(window->renderer, &info) != 0) {
@@ -6954,6 +7412,12 @@ static void free_window(struct sdlpui_window *window)
 	window->shorte = NULL;
 	window->detaild = NULL;
 
+	/* anything still queued would refer to the textures freed below */
+	if (window->batch != NULL) {
+		free_draw_batch(window->batch);
+		window->batch = NULL;
+	}
+
 	for (size_t i = 0; i < N_ELEMENTS(window->subwindows); i++) {
 		struct subwindow *subwindow = window->subwindows[i];
 		if (subwindow != NULL) {
@@ -26,12 +26,17 @@
 #include "main.h"
 #include "obj-init.h"
 #include "obj-randart.h"
+#include "obj-tval.h"
 #include "obj-util.h"
 #include "player-birth.h"
 #include "savefile.h"
 #include "ui-game.h"
 #include "wizard.h"
 
+#ifdef UNIX
+#include <sys/wait.h>
+#endif
+
 static struct {
 	char letter;
 	void (*func)(const char*);
@@ -49,8 +54,13 @@ const char help_spoil[] =
 	"              -a fname    Write artifact spoilers to fname;\n"
 	"                          if neither -p, -r, nor -s are used, uses\n"
 	"                          the standard artifacts\n"
+	"              -d fname    Write randart distribution statistics for a\n"
+	"                          batch of seeds to fname as CSV; the batch\n"
+	"                          starts at the -s seed or 0\n"
+	"              -j workers  Use that many processes for -d (default 1)\n"
 	"              -m fname    Write brief monster spoilers to fname\n"
 	"              -M fname    Write extended monster spoilers to fname\n"
+	"              -n count    Number of randart sets for -d (default 100)\n"
 	"              -o fname    Write object spoilers to fname\n"
 	"              -p          Use the artifacts associated with the\n"
 	"                          savefile set by main.c\n"
@@ -137,16 +147,316 @@ static uint32_t parse_seed(const char *src)
 	return result;
 }
 
+/**
+ * ------------------------------------------------------------------------
+ * Batch randart statistics
+ *
+ * Each set in the batch is boiled down to a row of integers:  the overall
+ * power figures, the number and mean power of artifacts for each tval, the
+ * rescaled ability frequencies, and the number of artifacts in each power
+ * band.  The rows are then aggregated column by column across the batch.
+ * ------------------------------------------------------------------------ */
+#define BATCH_POWER_BAND 50
+#define BATCH_POWER_BANDS 20
+
+enum {
+	BATCH_AVG_POWER,
+	BATCH_VAR_POWER,
+	BATCH_MAX_POWER,
+	BATCH_MIN_POWER,
+	BATCH_NEG_POWER,
+	BATCH_TV_NUM,
+	BATCH_TV_POWER = BATCH_TV_NUM + TV_MAX,
+	BATCH_ABILITY = BATCH_TV_POWER + TV_MAX,
+	BATCH_BAND = BATCH_ABILITY + ART_IDX_TOTAL,
+	/* One band for negative power and one for everything past the last */
+	BATCH_ROW_LEN = BATCH_BAND + BATCH_POWER_BANDS + 2
+};
+
+static const char *batch_set_names[] = {
+	"avg_power",
+	"var_power",
+	"max_power",
+	"min_power",
+	"neg_power_total"
+};
+
+static const char *batch_ability_names[] = {
+	#define ART_IDX(a, b) #a,
+	#include "list-randart-properties.h"
+	#undef ART_IDX
+};
+
+struct batch_column {
+	int n;
+	int min;
+	int max;
+	double sum;
+	double sum_sq;
+};
+
+/**
+ * Generate the set for one seed, record its row, and put back the standard
+ * artifacts for the next one.
+ */
+static void batch_fill_row(uint32_t seed, int *row)
+{
+	struct artifact_set_data *data = randart_set_statistics(seed);
+	int i;
+
+	memset(row, 0, BATCH_ROW_LEN * sizeof(*row));
+	row[BATCH_AVG_POWER] = data->avg_power;
+	row[BATCH_VAR_POWER] = data->var_power;
+	row[BATCH_MAX_POWER] = data->max_power;
+	row[BATCH_MIN_POWER] = data->min_power;
+	row[BATCH_NEG_POWER] = data->neg_power_total;
+	for (i = 0; i < TV_MAX; i++) {
+		row[BATCH_TV_NUM + i] = data->tv_num[i];
+		row[BATCH_TV_POWER + i] = data->avg_tv_power[i];
+	}
+	for (i = 0; i < ART_IDX_TOTAL; i++) {
+		row[BATCH_ABILITY + i] = data->art_probs[i];
+	}
+	for (i = 1; i < z_info->a_max; i++) {
+		int band;
+
+		if (!a_info[i].name) continue;
+		if (data->base_power[i] < 0) {
+			band = 0;
+		} else {
+			band = 1 + MIN(data->base_power[i] / BATCH_POWER_BAND,
+				BATCH_POWER_BANDS);
+		}
+		row[BATCH_BAND + band]++;
+	}
+	artifact_set_data_free(data);
+
+	cleanup_parser(&artifact_parser);
+	if (run_parser(&artifact_parser)) {
+		quit("Could not parse artifact.txt.");
+	}
+}
+
+static void batch_add_row(struct batch_column *cols, const int *row)
+{
+	int i;
+
+	for (i = 0; i < BATCH_ROW_LEN; i++) {
+		/* Mean power for a tval only means something if it has any */
+		if (i >= BATCH_TV_POWER && i < BATCH_TV_POWER + TV_MAX
+				&& !row[i - BATCH_TV_POWER + BATCH_TV_NUM]) {
+			continue;
+		}
+		if (!cols[i].n || row[i] < cols[i].min) cols[i].min = row[i];
+		if (!cols[i].n || row[i] > cols[i].max) cols[i].max = row[i];
+		cols[i].n++;
+		cols[i].sum += row[i];
+		cols[i].sum_sq += (double)row[i] * row[i];
+	}
+}
+
+static void batch_write_column(ang_file *fff, const char *stat,
+		const char *name, const struct batch_column *col)
+{
+	double mean, var;
+
+	if (!col->n) return;
+	mean = col->sum / col->n;
+	var = col->sum_sq / col->n - mean * mean;
+	file_putf(fff, "%s,%s,%d,%d,%d,%.2f,%.2f\n", stat, name, col->n,
+		col->min, col->max, mean, (var > 0) ? var : 0.0);
+}
+
+static bool batch_write_csv(const char *path, const struct batch_column *cols)
+{
+	ang_file *fff = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	char name[32];
+	int i;
+
+	if (!fff) return false;
+	file_putf(fff, "statistic,name,sets,min,max,mean,variance\n");
+	for (i = 0; i < (int)N_ELEMENTS(batch_set_names); i++) {
+		batch_write_column(fff, "set", batch_set_names[i], &cols[i]);
+	}
+	for (i = 1; i < TV_MAX; i++) {
+		/* Skip tvals that never get an artifact */
+		if (!cols[BATCH_TV_NUM + i].max) continue;
+		batch_write_column(fff, "tval_count", tval_find_name(i),
+			&cols[BATCH_TV_NUM + i]);
+		batch_write_column(fff, "tval_power", tval_find_name(i),
+			&cols[BATCH_TV_POWER + i]);
+	}
+	for (i = 0; i < ART_IDX_TOTAL; i++) {
+		batch_write_column(fff, "ability", batch_ability_names[i],
+			&cols[BATCH_ABILITY + i]);
+	}
+	batch_write_column(fff, "power_band", "negative", &cols[BATCH_BAND]);
+	for (i = 0; i < BATCH_POWER_BANDS; i++) {
+		strnfmt(name, sizeof(name), "%d-%d", i * BATCH_POWER_BAND,
+			(i + 1) * BATCH_POWER_BAND - 1);
+		batch_write_column(fff, "power_band", name,
+			&cols[BATCH_BAND + 1 + i]);
+	}
+	strnfmt(name, sizeof(name), "%d+", BATCH_POWER_BANDS * BATCH_POWER_BAND);
+	batch_write_column(fff, "power_band", name,
+		&cols[BATCH_BAND + 1 + BATCH_POWER_BANDS]);
+	return file_close(fff);
+}
+
+#ifdef UNIX
+/**
+ * Split the batch between worker processes.  Each generates its share of the
+ * seeds from its own copy of the standard artifacts and sends the rows back
+ * through a pipe.  Since the randart RNG is set up afresh from each seed,
+ * the results don't depend on the number of workers.
+ */
+static bool batch_run_workers(uint32_t first, int count, int workers,
+		struct batch_column *cols)
+{
+	pid_t *pids = mem_zalloc(workers * sizeof(*pids));
+	int *fds = mem_zalloc(workers * sizeof(*fds));
+	int *row = mem_alloc(BATCH_ROW_LEN * sizeof(*row));
+	bool result = true;
+	int i, started = 0;
+
+	/* Make sure buffered output isn't written once per worker */
+	fflush(stdout);
+	for (i = 0; i < workers; i++) {
+		int lo = (int)(((long)count * i) / workers);
+		int hi = (int)(((long)count * (i + 1)) / workers);
+		int p[2];
+
+		if (pipe(p) != 0) {
+			result = false;
+			break;
+		}
+		pids[i] = fork();
+		if (pids[i] < 0) {
+			close(p[0]);
+			close(p[1]);
+			result = false;
+			break;
+		}
+		if (pids[i] == 0) {
+			int j;
+
+			close(p[0]);
+			for (j = 0; j < i; j++) {
+				close(fds[j]);
+			}
+			for (j = lo; j < hi; j++) {
+				size_t left = BATCH_ROW_LEN * sizeof(*row);
+				char *buf = (char *)row;
+
+				batch_fill_row(first + (uint32_t)j, row);
+				while (left > 0) {
+					ssize_t n = write(p[1], buf, left);
+
+					if (n <= 0) _exit(1);
+					buf += n;
+					left -= n;
+				}
+			}
+			close(p[1]);
+			_exit(0);
+		}
+		close(p[1]);
+		fds[i] = p[0];
+		started++;
+	}
+
+	/* Collect the rows in seed order */
+	for (i = 0; i < started; i++) {
+		int lo = (int)(((long)count * i) / workers);
+		int hi = (int)(((long)count * (i + 1)) / workers);
+		int j, status;
+
+		for (j = lo; j < hi && result; j++) {
+			size_t left = BATCH_ROW_LEN * sizeof(*row);
+			char *buf = (char *)row;
+
+			while (left > 0) {
+				ssize_t n = read(fds[i], buf, left);
+
+				if (n <= 0) break;
+				buf += n;
+				left -= n;
+			}
+			if (left > 0) {
+				result = false;
+			} else {
+				batch_add_row(cols, row);
+			}
+		}
+		close(fds[i]);
+		if (waitpid(pids[i], &status, 0) != pids[i]
+				|| !WIFEXITED(status) || WEXITSTATUS(status)) {
+			result = false;
+		}
+	}
+
+	mem_free(row);
+	mem_free(fds);
+	mem_free(pids);
+	return result;
+}
+#endif
+
+/**
+ * Generate count randart sets with consecutive seeds from first and write
+ * the distribution of their statistics to path.  The standard artifacts are
+ * in a_info before and after.
+ */
+static bool write_randart_batch(const char *path, uint32_t first, int count,
+		int workers)
+{
+	struct batch_column *cols = mem_zalloc(BATCH_ROW_LEN * sizeof(*cols));
+	bool result = true;
+
+	if (workers > count) workers = count;
+#ifdef UNIX
+	if (workers > 1) {
+		result = batch_run_workers(first, count, workers, cols);
+	} else
+#endif
+	{
+		int *row = mem_alloc(BATCH_ROW_LEN * sizeof(*row));
+		int i;
+
+		for (i = 0; i < count; i++) {
+			batch_fill_row(first + (uint32_t)i, row);
+			batch_add_row(cols, row);
+		}
+		mem_free(row);
+	}
+
+	if (result) {
+		result = batch_write_csv(path, cols);
+	}
+	mem_free(cols);
+	return result;
+}
+
 /**
  * Usage:
  *
- * angband -mspoil -- [-a fname] [-m fname] [-M fname] [-o fname] \
- *     [-p] [-r fname] [-s seed]
+ * angband -mspoil -- [-a fname] [-d fname] [-j workers] [-m fname] \
+ *     [-M fname] [-n count] [-o fname] [-p] [-r fname] [-s seed]
  *
  *   -a fname  Write artifact spoilers to a file named fname.  If neither -p,
  *             -r, nor -s are used, the artifacts will be the standard set.
+ *   -d fname  Generate a batch of randart sets, with consecutive seeds
+ *             starting from the one given by -s or from 0 if -s is not used,
+ *             and write the distributions of their power ratings and ability
+ *             frequencies to a file named fname as CSV.  Each row is one
+ *             per-set quantity:  its name, the number of sets it applies to,
+ *             and its minimum, maximum, mean and variance across those
+ *             sets.
+ *   -j workers  Split the sets for -d between that many processes.  The
+ *             default is 1; only Unix-like systems can use more.
  *   -m fname  Write brief monster spoilers to a file named fname.
  *   -M fname  Write extended monster spoilers to a file named fname.
+ *   -n count  Generate count sets for -d.  The default is 100.
  *   -o fname  Write object spoilers to a file named fname.
  *   -p        Use the artifacts associated with savefile set by main.c.
  *   -r fname  Use the randart file, fname, as the source of the artifacts.
@@ -174,6 +484,8 @@ errr init_spoil(int argc, char *argv[]) {
 	const char *randart_name = NULL;
 	bool have_specified_seed = false;
 	uint32_t specified_seed = 0;
+	const char *batch_name = NULL;
+	int batch_count = 100, batch_workers = 1;
 
 	/* Parse the arguments. */
 	while (1) {
@@ -199,6 +511,39 @@ errr init_spoil(int argc, char *argv[]) {
 					printf("init-spoil: '%s' requires an argument, the name of a randart file\n", argv[i]);
 					result = 1;
 				}
+			} else if (argv[i][1] == 'd' && argv[i][2] == '\0') {
+				if (i < argc - 1) {
+					batch_name = argv[i + 1];
+					++increment;
+				} else {
+					printf("init-spoil: '%s' requires an argument, the name of the statistics file\n", argv[i]);
+					result = 1;
+				}
+			} else if ((argv[i][1] == 'n' || argv[i][1] == 'j')
+					&& argv[i][2] == '\0') {
+				if (i < argc - 1) {
+					char *valend;
+					long val;
+
+					val = strtol(argv[i + 1], &valend, 10);
+					++increment;
+					if (argv[i + 1][0] != '\0'
+							&& contains_only_spaces(valend)
+							&& val > 0 && val <= 1000000) {
+						if (argv[i][1] == 'n') {
+							batch_count = (int)val;
+						} else {
+							batch_workers = (int)val;
+						}
+					} else {
+						printf("init-spoil: '%s' requires a positive integer argument\n",
+							argv[i]);
+						result = 1;
+					}
+				} else {
+					printf("init-spoil: '%s' requires an argument, a positive integer\n", argv[i]);
+					result = 1;
+				}
 			} else if (argv[i][1] == 's' && argv[i][2] == '\0') {
 				if (i < argc - 1) {
 					char *valend;
@@ -272,7 +617,20 @@ errr init_spoil(int argc, char *argv[]) {
 	/* Generate the spoilers. */
 	init_angband();
 
-	if (load_randart) {
+	/* The batch works from the standard artifacts, so do it first. */
+	if (batch_name) {
+		if (!player_make_simple(NULL, NULL, "Spoiler")) {
+			printf("init-spoil: could not initialize player.\n");
+			result = 1;
+		} else if (!write_randart_batch(batch_name, specified_seed,
+				batch_count, batch_workers)) {
+			printf("init-spoil: could not write randart statistics to '%s'.\n",
+				batch_name);
+			result = 1;
+		}
+	}
+
+	if (result == 0 && load_randart) {
 		if (randart_name || have_specified_seed) {
 			if (player_make_simple(NULL, NULL, "Spoiler")) {
 				char defname[1024] = "";
@@ -298,7 +656,7 @@ errr init_spoil(int argc, char *argv[]) {
 					}
 				} else {
 					seed_randart = specified_seed;
-					do_randart(seed_randart, true);
+					do_randart(seed_randart, true, true);
 				}
 
 				if (result == 0) {
@@ -349,7 +707,8 @@ errr init_spoil(int argc, char *argv[]) {
 				result = 1;
 			}
 		}
-	} else if (!player_make_simple(NULL, NULL, "Spoiler")) {
+	} else if (result == 0
+			&& !player_make_simple(NULL, NULL, "Spoiler")) {
 		printf("init-spoil: could not initialize player.\n");
 		result = 1;
 	}
@@ -27,6 +27,7 @@
 #include "ui-input.h"
 #include "ui-prefs.h"
 #include "ui-signals.h"
+#include "ui-spectator.h"
 
 #ifdef SOUND
 #include "sound.h"
@@ -91,6 +92,14 @@ static const struct module modules[] =
 	{ "spoil", help_spoil, init_spoil, false },
 #endif
 
+#ifdef USE_BENCH
+	{ "bench", help_bench, init_bench, false },
+#endif /* USE_BENCH */
+
+#ifdef USE_FARM
+	{ "farm", help_farm, init_farm, false },
+#endif /* USE_FARM */
+
 #ifdef USE_IBM
 	{ "ibm", help_ibm, init_ibm, false },
 #endif /* USE_IBM */
@@ -136,6 +145,9 @@ static void extended_quit_hook(const char *s)
 	cleanup_angband();
 #ifdef SOUND
 	close_sound();
+#endif
+#ifdef USE_SPECTATOR
+	spectator_close();
 #endif
 	if (quit_nested) {
 		(*quit_nested)(s);
@@ -346,6 +358,9 @@ int main(int argc, char *argv[])
 	bool done = false;
 
 	const char *mstr = NULL;
+#ifdef USE_SPECTATOR
+	const char *spectator_str = NULL;
+#endif
 	bool args = true;
 
 	/* Save the "program name" XXX XXX XXX */
@@ -449,6 +464,12 @@ int main(int argc, char *argv[])
 			case 'd':
 				change_path(arg);
 				continue;
+#ifdef USE_SPECTATOR
+			case 'b':
+				if (!*arg) goto usage;
+				spectator_str = arg;
+				continue;
+#endif
 
 			case '-':
 				argv[i] = argv[0];
@@ -474,6 +495,9 @@ int main(int argc, char *argv[])
 					printf("    %s (default is %s)\n", change_path_values[i].name, *change_path_values[i].path);
 				}
 				puts("                 Multiple -d options are allowed.");
+#ifdef USE_SPECTATOR
+				puts("  -b<name>       Publish the main screen to spectators as shared memory <name>");
+#endif
 #ifdef SOUND
 				puts("  -s<mod>        Use sound module <sys>:");
 				print_sound_help();
@@ -574,6 +598,12 @@ int main(int argc, char *argv[])
 	quit_nested = quit_aux;
 	quit_aux = extended_quit_hook;
 
+#ifdef USE_SPECTATOR
+	/* Let spectators watch from the splash screen on */
+	if (spectator_str && !spectator_open(spectator_str))
+		quit_fmt("Unable to publish the screen as '%s'", spectator_str);
+#endif
+
 	/* Wait for response */
 	pause_line(Term);
 	if (!terms_disconnecting) {
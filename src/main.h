@@ -41,6 +41,8 @@ extern errr init_sdl2(int argc, char **argv);
 extern errr init_test(int argc, char **argv);
 extern errr init_stats(int argc, char **argv);
 extern errr init_spoil(int argc, char **argv);
+extern errr init_bench(int argc, char **argv);
+extern errr init_farm(int argc, char **argv);
 
 
 extern const char help_lfb[];
@@ -61,6 +63,8 @@ extern const char help_sdl2[];
 extern const char help_test[];
 extern const char help_stats[];
 extern const char help_spoil[];
+extern const char help_bench[];
+extern const char help_farm[];
 
 
 struct module
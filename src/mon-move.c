@@ -1688,30 +1688,42 @@ static void monster_turn(struct monster *mon)
  * gets a turn, and/or to decide whether it gets a turn
  * ------------------------------------------------------------------------ */
 /**
- * Determine whether a monster is active or passive
+ * Say whether a monster would be active or passive if it moved now
  */
-static bool monster_check_active(struct monster *mon)
+static bool monster_is_active_now(struct monster *mon)
 {
 	if ((mon->cdis <= mon->race->hearing) && monster_passes_walls(mon)) {
 		/* Character is inside scanning range, monster can go straight there */
-		mflag_on(mon->mflag, MFLAG_ACTIVE);
+		return true;
 	} else if (mon->hp < mon->maxhp) {
 		/* Monster is hurt */
-		mflag_on(mon->mflag, MFLAG_ACTIVE);
+		return true;
 	} else if (square_isview(cave, mon->grid)) {
 		/* Monster can "see" the player (checked backwards) */
-		mflag_on(mon->mflag, MFLAG_ACTIVE);
+		return true;
 	} else if (monster_can_hear(mon)) {
 		/* Monster can hear the player */
-		mflag_on(mon->mflag, MFLAG_ACTIVE);
+		return true;
 	} else if (monster_can_smell(mon)) {
 		/* Monster can smell the player */
-		mflag_on(mon->mflag, MFLAG_ACTIVE);
+		return true;
 	} else if (monster_taking_terrain_damage(cave, mon)) {
 		/* Monster is taking damage from the terrain */
+		return true;
+	}
+
+	/* Otherwise go passive */
+	return false;
+}
+
+/**
+ * Determine whether a monster is active or passive
+ */
+static bool monster_check_active(struct monster *mon)
+{
+	if (monster_is_active_now(mon)) {
 		mflag_on(mon->mflag, MFLAG_ACTIVE);
 	} else {
-		/* Otherwise go passive */
 		mflag_off(mon->mflag, MFLAG_ACTIVE);
 	}
 
@@ -1868,6 +1880,24 @@ static void regen_monster(struct monster *mon, int num)
 }
 
 
+/**
+ * Net speed of a monster, including timed effects
+ */
+static int monster_turn_speed(const struct monster *mon)
+{
+	int mspeed = mon->mspeed;
+
+	if (mon->m_timed[MON_TMD_FAST])
+		mspeed += 10;
+	if (mon->m_timed[MON_TMD_SLOW]) {
+		int slow_level = monster_effect_level(mon, MON_TMD_SLOW);
+		mspeed -= (2 * slow_level);
+	}
+
+	return mspeed;
+}
+
+
 /**
  * ------------------------------------------------------------------------
  * Monster processing routines to be called by the main game loop
@@ -1886,7 +1916,6 @@ static void regen_monster(struct monster *mon, int num)
 void process_monsters(int minimum_energy)
 {
 	int i;
-	int mspeed;
 
 	/* Only process some things every so often */
 	bool regen = false;
@@ -1924,17 +1953,8 @@ void process_monsters(int minimum_energy)
 		if (regen)
 			regen_monster(mon, 1);
 
-		/* Calculate the net speed */
-		mspeed = mon->mspeed;
-		if (mon->m_timed[MON_TMD_FAST])
-			mspeed += 10;
-		if (mon->m_timed[MON_TMD_SLOW]) {
-			int slow_level = monster_effect_level(mon, MON_TMD_SLOW);
-			mspeed -= (2 * slow_level);
-		}
-
 		/* Give this monster some energy */
-		mon->energy += turn_energy(mspeed);
+		mon->energy += turn_energy(monster_turn_speed(mon));
 
 		/* End the turn of monsters without enough energy to move */
 		if (!moving)
@@ -1981,6 +2001,78 @@ void process_monsters(int minimum_energy)
 	player->upkeep->update |= PU_MONSTERS;
 }
 
+/**
+ * Pass up to limit game turns in which no monster would do more than gain
+ * energy or doze, returning how many were passed.
+ *
+ * Monsters fall into three tiers here.  Passive monsters are dormant:  over
+ * the run each gets exactly what process_monsters(0) would have given it
+ * turn by turn, its energy and, for any turns in which it would have moved,
+ * the energy spent and its passive status.  Active monsters which are asleep
+ * are dozing:  their moves only lighten their sleep, so they make them here,
+ * in the same order and with the same random numbers as the turn by turn
+ * passes would, and the run ends with the turn in which one of them wakes.
+ * Any other active monster acts, so the run stops short of the first turn
+ * one would move in.  Nothing else can change while nobody acts, so a
+ * monster keeps its tier for the whole run.  No monster may be marked as
+ * handled; the caller is responsible for not passing over the turns
+ * processing the world or the player.  Nothing is passed once the player
+ * is dead or leaving the level.
+ */
+int skip_monster_turns(int limit)
+{
+	int i, j;
+
+	/* process_monsters() would do nothing on a level being left */
+	if (player->is_dead || !player->upkeep->playing
+			|| player->upkeep->generate_level) {
+		return 0;
+	}
+
+	/* Find the first turn in which an active monster would act */
+	for (i = cave_monster_max(cave) - 1; i >= 1 && limit > 0; i--) {
+		struct monster *mon = cave_monster(cave, i);
+		int gain;
+
+		if (!mon->race) continue;
+		if (monster_is_mimicking(mon) || !monster_is_active_now(mon))
+			continue;
+		if (mon->m_timed[MON_TMD_SLEEP]) continue;
+
+		gain = turn_energy(monster_turn_speed(mon));
+		if (mon->energy >= z_info->move_energy) return 0;
+		if (gain > 0) {
+			limit = MIN(limit, (z_info->move_energy - mon->energy
+				+ gain - 1) / gain);
+		}
+	}
+
+	/* Hand out the energy turn by turn, and spend it as monsters move */
+	for (j = 0; j < limit; j++) {
+		for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
+			struct monster *mon = cave_monster(cave, i);
+			bool moving;
+
+			if (!mon->race) continue;
+
+			moving = mon->energy >= z_info->move_energy;
+			mon->energy += turn_energy(monster_turn_speed(mon));
+			if (!moving) continue;
+			mon->energy -= z_info->move_energy;
+
+			/* Lying in wait, passive, or dozing */
+			if (monster_is_mimicking(mon)) continue;
+			if (!monster_check_active(mon)) continue;
+			(void)process_monster_timed(mon);
+
+			/* A monster that woke up may act from the next turn */
+			if (!mon->m_timed[MON_TMD_SLEEP]) limit = j + 1;
+		}
+	}
+
+	return MAX(limit, 0);
+}
+
 /**
  * Clear 'moved' status from all monsters.
  *
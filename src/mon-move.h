@@ -27,6 +27,7 @@ enum monster_stagger {
 
 bool multiply_monster(const struct monster *mon);
 void process_monsters(int minimum_energy);
+int skip_monster_turns(int limit);
 void reset_monsters(void);
 void restore_monsters(void);
 
@@ -881,12 +881,15 @@ static int obj_known_blows(const struct object *obj, int max_num,
 	/* Pretend we're wielding the object */
 	player->body.slots[weapon_slot].obj = (struct object *) obj;
 
-	/* Calculate the player's hypothetical state */
+	/* Calculate the player's hypothetical state, just the once */
 	memcpy(&state, &player->state, sizeof(state));
 	state.stat_ind[STAT_STR] = 0; //Hack - NRM
 	state.stat_ind[STAT_DEX] = 0; //Hack - NRM
 	calc_bonuses(player, &state, true, false);
 
+	/* Stop pretending */
+	player->body.slots[weapon_slot].obj = current_weapon;
+
 	/* First entry is always the current num of blows. */
 	possible_blows[num].str_plus = 0;
 	possible_blows[num].dex_plus = 0;
@@ -905,14 +908,12 @@ static int obj_known_blows(const struct object *obj, int max_num,
 
 			/* Unlikely */
 			if (num == max_num) {
-				player->body.slots[weapon_slot].obj = current_weapon;
 				return num;
 			}
 
-			state.stat_ind[STAT_STR] = str_plus; //Hack - NRM
-			state.stat_ind[STAT_DEX] = dex_plus; //Hack - NRM
-			calc_bonuses(player, &state, true, false);
-			new_blows = state.num_blows;
+			/* Only the blows can change, so skip the full recalculation */
+			new_blows = calc_blows_with_stat_plus(player, obj, &state,
+				str_plus, dex_plus);
 
 			/* Test to make sure that this extra blow is a
 			 * new str/dex combination, not a repeat */
@@ -944,9 +945,6 @@ static int obj_known_blows(const struct object *obj, int max_num,
 		}
 	}
 
-	/* Stop pretending */
-	player->body.slots[weapon_slot].obj = current_weapon;
-
 	return num;
 }
 
@@ -1211,11 +1211,80 @@ void player_know_object(struct player *p, struct object *obj)
 }
 
 /**
- * Propagate player knowledge of objects to all objects
+ * Check whether the known version of an object is behind changes to the
+ * object's charges, combat bonuses, flags or curses which the player already
+ * knows how to see
  *
  * \param p is the player
+ * \param obj is the object
  */
-void update_player_object_knowledge(struct player *p)
+static bool object_knowledge_is_stale(const struct player *p,
+		const struct object *obj)
+{
+	bitflag flags[OF_SIZE], known_flags[OF_SIZE];
+	int i;
+
+	if (obj->known->pval != obj->pval && !tval_is_chest(obj)) return true;
+	of_copy(flags, obj->flags);
+	of_inter(flags, p->obj_k->flags);
+	of_copy(known_flags, obj->known->flags);
+	of_inter(known_flags, p->obj_k->flags);
+	if (!of_is_equal(flags, known_flags)) return true;
+	if (obj->known->to_a != p->obj_k->to_a * obj->to_a) return true;
+	if (!object_has_standard_to_h(obj)
+			&& obj->known->to_h != p->obj_k->to_h * obj->to_h)
+		return true;
+	if (obj->known->to_d != p->obj_k->to_d * obj->to_d) return true;
+	if (obj->curses || obj->known->curses) {
+		for (i = 1; i < z_info->curse_max; i++) {
+			int power = obj->curses && p->obj_k->curses[i].power ?
+				obj->curses[i].power : 0;
+			int known = obj->known->curses ?
+				obj->known->curses[i].power : 0;
+
+			if (power != known) return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Check whether learning a rune can change what is known about an object
+ *
+ * Besides the object carrying the rune, an unrecognised ego may become known
+ * through a rune the object itself lacks, and learning an element reveals the
+ * object's other properties for that element.  Charges, bonuses, flags and
+ * curses changed since the object was last updated, as by stores using up
+ * charges or curses blasting equipment, are only brought up to date here, so
+ * those objects count as well.  Curse objects are cheap, so they are always
+ * updated.
+ *
+ * \param p is the player
+ * \param obj is the object
+ * \param i is the rune index
+ */
+static bool rune_affects_object(const struct player *p,
+		const struct object *obj, size_t i)
+{
+	struct rune *r = &rune_list[i];
+
+	if (!obj || !obj->known) return false;
+	if (!obj->kind) return true;
+	if (object_has_rune(obj, i)) return true;
+	if (obj->ego && !obj->known->ego) return true;
+	if (r->variety == RUNE_VAR_RESIST && obj->el_info[r->index].flags)
+		return true;
+	return object_knowledge_is_stale(p, obj);
+}
+
+/**
+ * Propagate player knowledge of objects to objects
+ *
+ * \param p is the player
+ * \param rune is the index of a newly learned rune, so that only objects it
+ * affects are updated, or -1 to update all objects
+ */
+static void update_player_object_knowledge_aux(struct player *p, int rune)
 {
 	int i;
 	struct object *obj;
@@ -1223,17 +1292,21 @@ void update_player_object_knowledge(struct player *p)
 	/* Level objects */
 	if (cave)
 		for (i = 0; i < cave->obj_max; i++)
-			player_know_object(p, cave->objects[i]);
+			if (rune < 0
+					|| rune_affects_object(p, cave->objects[i], rune))
+				player_know_object(p, cave->objects[i]);
 
 	/* Player objects */
 	for (obj = p->gear; obj; obj = obj->next)
-		player_know_object(p, obj);
+		if (rune < 0 || rune_affects_object(p, obj, rune))
+			player_know_object(p, obj);
 
 	/* Store objects */
 	for (i = 0; i < z_info->store_max; i++) {
 		struct store *s = &stores[i];
 		for (obj = s->stock; obj; obj = obj->next)
-			player_know_object(p, obj);
+			if (rune < 0 || rune_affects_object(p, obj, rune))
+				player_know_object(p, obj);
 	}
 
 	/* Curse objects */
@@ -1245,23 +1318,35 @@ void update_player_object_knowledge(struct player *p)
 	if (cave)
 		autoinscribe_ground(p);
 	autoinscribe_pack(p);
+	p->upkeep->update |= (PU_BONUS);
 	event_signal(EVENT_INVENTORY);
 	event_signal(EVENT_EQUIPMENT);
 }
 
+/**
+ * Propagate player knowledge of objects to all objects
+ *
+ * \param p is the player
+ */
+void update_player_object_knowledge(struct player *p)
+{
+	update_player_object_knowledge_aux(p, -1);
+}
+
 /**
  * ------------------------------------------------------------------------
  * Object knowledge learners
  * These functions are for increasing player knowledge of object properties
  * ------------------------------------------------------------------------ */
 /**
- * Learn a given rune
+ * Learn a given rune without passing the knowledge on to objects
  *
  * \param p is the player
  * \param i is the rune index
  * \param message is whether or not to print a message
+ * \return whether the rune was new to the player
  */
-static void player_learn_rune(struct player *p, size_t i, bool message)
+static bool player_learn_rune_aux(struct player *p, size_t i, bool message)
 {
 	struct rune *r = &rune_list[i];
 	bool learned = false;
@@ -1363,14 +1448,27 @@ static void player_learn_rune(struct player *p, size_t i, bool message)
 	}
 
 	/* Nothing learned */
-	if (!learned) return;
+	if (!learned) return false;
 
 	/* Give a message */
 	if (message)
 		msgt(MSG_RUNE, "You have learned the rune of %s.", rune_name(i));
 
-	/* Update knowledge */
-	update_player_object_knowledge(p);
+	return true;
+}
+
+/**
+ * Learn a given rune
+ *
+ * \param p is the player
+ * \param i is the rune index
+ * \param message is whether or not to print a message
+ */
+static void player_learn_rune(struct player *p, size_t i, bool message)
+{
+	/* Update knowledge of the objects the rune could change */
+	if (player_learn_rune_aux(p, i, message))
+		update_player_object_knowledge_aux(p, i);
 }
 
 /**
@@ -1379,7 +1477,6 @@ static void player_learn_rune(struct player *p, size_t i, bool message)
 void player_learn_flag(struct player *p, int flag)
 {
 	player_learn_rune(p, rune_index(RUNE_VAR_FLAG, flag), true);
-	update_player_object_knowledge(p);
 }
 
 /**
@@ -1401,7 +1498,6 @@ void player_learn_slay(struct player *p, int index)
 
 		/* Learn the rune */
 		player_learn_rune(p, rune_index(RUNE_VAR_SLAY, i), true);
-		update_player_object_knowledge(p);
 	}
 }
 
@@ -1424,7 +1520,6 @@ void player_learn_brand(struct player *p, int index)
 
 		/* Learn the rune */
 		player_learn_rune(p, rune_index(RUNE_VAR_BRAND, i), true);
-		update_player_object_knowledge(p);
 	}
 }
 
@@ -1438,7 +1533,6 @@ void player_learn_curse(struct player *p, struct curse *curse)
 	if (index >= 0) {
 		player_learn_rune(p, index, true);
 	}
-	update_player_object_knowledge(p);
 }
 
 /**
@@ -1453,16 +1547,18 @@ void player_learn_innate(struct player *p)
 	/* Elements */
 	for (element = 0; element < ELEM_MAX; element++) {
 		if (p->race->el_info[element].res_level != 0) {
-			player_learn_rune(p, rune_index(RUNE_VAR_RESIST, element), false);
+			player_learn_rune_aux(p,
+				rune_index(RUNE_VAR_RESIST, element), false);
 		}
 	}
 
 	/* Flags */
 	for (flag = of_next(p->race->flags, FLAG_START); flag != FLAG_END;
 		 flag = of_next(p->race->flags, flag + 1)) {
-		player_learn_rune(p, rune_index(RUNE_VAR_FLAG, flag), false);
+		player_learn_rune_aux(p, rune_index(RUNE_VAR_FLAG, flag), false);
 	}
 
+	/* Update knowledge once for all of them */
 	update_player_object_knowledge(p);
 }
 
@@ -1474,9 +1570,15 @@ void player_learn_innate(struct player *p)
 void player_learn_all_runes(struct player *p)
 {
 	size_t i;
+	bool learned = false;
 
 	for (i = 0; i < rune_max; i++)
-		player_learn_rune(p, i, false);
+		if (player_learn_rune_aux(p, i, false))
+			learned = true;
+
+	/* Update knowledge once for all of them */
+	if (learned)
+		update_player_object_knowledge(p);
 }
 
 /**
@@ -1804,6 +1906,7 @@ void object_learn_unknown_rune(struct player *p, struct object *obj)
 	if (i < 0) {
 		obj->known->notice |= OBJ_NOTICE_ASSESSED;
 		player_know_object(player, obj);
+		p->upkeep->update |= (PU_BONUS);
 		return;
 	}
 
@@ -2289,6 +2392,9 @@ void object_flavor_aware(struct player *p, struct object *obj)
 			object_set_base_known(p, obj1);
 	}
 
+	/* Equipment bonuses may now be known */
+	p->upkeep->update |= (PU_BONUS);
+
 	/* Quit if no dungeon yet */
 	if (!cave) return;
 
@@ -179,17 +179,41 @@ static int16_t art_idx_high_resist[] =	{
  * ------------------------------------------------------------------------
  * Calculation of the statistics of an artifact set
  * ------------------------------------------------------------------------ */
+/**
+ * Return the power of an artifact without logging anything.  The fake object
+ * lives on the stack and is never described, so this is much cheaper than
+ * the logged evaluation.
+ */
+static int artifact_power_quiet(const struct artifact *art)
+{
+	struct object obj;
+	int32_t power;
+
+	memset(&obj, 0, sizeof(obj));
+	if (!make_fake_artifact(&obj, art)) return 0;
+	power = object_power(&obj, false, NULL);
+	mem_free(obj.slays);
+	mem_free(obj.brands);
+	mem_free(obj.curses);
+	return power;
+}
+
 /**
  * Return the artifact power, by generating a "fake" object based on the
  * artifact, and calling the common object_power function
  */
 static int artifact_power(int a_idx, const char *reason, bool verbose)
 {
-	struct object *obj = object_new();
-	struct object *known_obj = object_new();
+	struct object *obj;
+	struct object *known_obj;
 	char buf[256];
 	int32_t power;
 
+	/* Nobody will read the details */
+	if (!log_file) return artifact_power_quiet(&a_info[a_idx]);
+
+	obj = object_new();
+	known_obj = object_new();
 	file_putf(log_file, "********** Evaluating %s ********\n", reason);
 	file_putf(log_file, "Artifact index is %d\n", a_idx);
 
@@ -2703,6 +2727,70 @@ static void copy_artifact(struct artifact *a_src, struct artifact *a_dst)
 	}
 }
 
+/**
+ * Check whether an artifact has any curses.
+ */
+static bool artifact_is_cursed(const struct artifact *art)
+{
+	int i;
+
+	if (!art->curses) return false;
+	for (i = 0; i < z_info->curse_max; i++) {
+		if (art->curses[i]) return true;
+	}
+	return false;
+}
+
+/**
+ * Check whether two artifacts have the same power, by comparing everything
+ * copy_artifact_data() passes on to the fake object that gets evaluated.
+ */
+static bool artifact_same_power(const struct artifact *a1,
+		const struct artifact *a2)
+{
+	int i;
+
+	if (a1->tval != a2->tval || a1->sval != a2->sval
+			|| a1->to_h != a2->to_h || a1->to_d != a2->to_d
+			|| a1->to_a != a2->to_a || a1->ac != a2->ac
+			|| a1->dd != a2->dd || a1->ds != a2->ds
+			|| a1->weight != a2->weight
+			|| a1->activation != a2->activation
+			|| !of_is_equal(a1->flags, a2->flags)) {
+		return false;
+	}
+	if (a1->activation && memcmp(&a1->time, &a2->time, sizeof(a1->time))) {
+		return false;
+	}
+	for (i = 0; i < OBJ_MOD_MAX; i++) {
+		if (a1->modifiers[i] != a2->modifiers[i]) return false;
+	}
+	for (i = 0; i < ELEM_MAX; i++) {
+		if (a1->el_info[i].res_level != a2->el_info[i].res_level
+				|| a1->el_info[i].flags != a2->el_info[i].flags) {
+			return false;
+		}
+	}
+
+	/* A missing array and an empty one are treated as different */
+	if ((a1->slays == NULL) != (a2->slays == NULL)
+			|| (a1->slays && memcmp(a1->slays, a2->slays,
+			z_info->slay_max * sizeof(bool)))) {
+		return false;
+	}
+	if ((a1->brands == NULL) != (a2->brands == NULL)
+			|| (a1->brands && memcmp(a1->brands, a2->brands,
+			z_info->brand_max * sizeof(bool)))) {
+		return false;
+	}
+	if ((a1->curses == NULL) != (a2->curses == NULL)
+			|| (a1->curses && memcmp(a1->curses, a2->curses,
+			z_info->curse_max * sizeof(int)))) {
+		return false;
+	}
+	return true;
+}
+
 /**
  * ------------------------------------------------------------------------
  * Generation of a set of random artifacts
@@ -2756,7 +2844,8 @@ static void design_artifact(struct artifact_set_data *data, int tv, int *aidx)
 	int art_level = art->level;
 	int tries;
 	int alloc_new;
-	int ap = 0;
+	int ap = 0, art_ap = 0, old_ap = 0;
+	bool art_ap_known = false, old_ap_known = false;
 	bool hurt_me = false;
 
 	/* Set tval if necessary */
@@ -2844,6 +2933,9 @@ static void design_artifact(struct artifact_set_data *data, int tv, int *aidx)
 		/* Too powerful -- put it back */
 		copy_artifact(a_old, art);
 		file_putf(log_file, "--- Supercharge is too powerful! Rolling back.\n");
+	} else {
+		art_ap = ap;
+		art_ap_known = true;
 	}
 
 	/* Give this artifact a chance to be cursed - note it retains its power */
@@ -2856,12 +2948,29 @@ static void design_artifact(struct artifact_set_data *data, int tv, int *aidx)
 		/* Copy artifact info temporarily. */
 		copy_artifact(art, a_old);
 
+		/* The copy drops any activation, so may not share the power */
+		old_ap = art_ap;
+		old_ap_known = art_ap_known && !art->activation;
+
 		/* Add an ability */
 		add_ability(art, power, art_freq, data);
 		remove_contradictory(art);
 
-		/* Check the power, handle negative power */
-		ap = artifact_power(*aidx, "artifact attempt", true);
+		/*
+		 * Check the power, handle negative power.  Often nothing was
+		 * added, and then the last power found still holds.  Making
+		 * the fake object for a cursed artifact rolls curse timeouts,
+		 * so those are always evaluated to keep the random sequence,
+		 * and with it the artifact set, the same.
+		 */
+		if (old_ap_known && !log_file && !artifact_is_cursed(art)
+				&& artifact_same_power(art, a_old)) {
+			ap = old_ap;
+		} else {
+			ap = artifact_power(*aidx, "artifact attempt", true);
+		}
+		art_ap = ap;
+		art_ap_known = true;
 		if (ap < 0) {
 			ap = -ap;
 			break;
@@ -2870,6 +2979,7 @@ static void design_artifact(struct artifact_set_data *data, int tv, int *aidx)
 		/* Curse the designated artifacts */
 		if (hurt_me) {
 			make_bad(art, art_level);
+			art_ap_known = false;
 			if (one_in_(3)) {
 				hurt_me = false;
 			}
@@ -2880,6 +2990,8 @@ static void design_artifact(struct artifact_set_data *data, int tv, int *aidx)
 			/* Too powerful -- put it back */
 			copy_artifact(a_old, art);
 			file_putf(log_file, "--- Too powerful!  Rolling back.\n");
+			art_ap = old_ap;
+			art_ap_known = old_ap_known;
 			continue;
 		} else if (ap >= (power * 19) / 20) {
 			/* Just right */
@@ -2990,7 +3102,7 @@ static void create_artifact_set(struct artifact_set_data *data)
 /**
  * Allocate a new artifact set data structure
  */
-static struct artifact_set_data *artifact_set_data_new(void)
+struct artifact_set_data *artifact_set_data_new(void)
 {
 	struct artifact_set_data *data = mem_zalloc(sizeof(*data));
 
@@ -3019,9 +3131,9 @@ static struct artifact_set_data *artifact_set_data_new(void)
 }
 
 /**
- * Allocate a new artifact set data structure
+ * Free an artifact set data structure
  */
-static void artifact_set_data_free(struct artifact_set_data *data)
+void artifact_set_data_free(struct artifact_set_data *data)
 {
 	mem_free(data->base_power);
 	mem_free(data->avg_tv_power);
@@ -3149,11 +3261,20 @@ static void write_randart_entry(ang_file *fff, const struct artifact *art)
 }
 
 /**
- * Randomize the artifacts
+ * Randomize the artifacts without writing any files and return the
+ * statistics for the new set.
+ *
+ * \param randart_seed is the seed for the generation.
+ * \return the power ratings and ability frequencies of the generated set, as
+ * store_base_power() and parse_frequencies() leave them; release it with
+ * artifact_set_data_free().
+ *
+ * Like do_randart(), this overwrites a_info, so callers wanting another set
+ * from the standard artifacts have to reload those first.  Generation is
+ * logged to log_file when that is open.
  */
-void do_randart(uint32_t randart_seed, bool create_file)
+struct artifact_set_data *randart_set_statistics(uint32_t randart_seed)
 {
-	char fname[1024];
 	struct artifact_set_data *standarts = artifact_set_data_new();
 	struct artifact_set_data *randarts;
 
@@ -3161,15 +3282,6 @@ void do_randart(uint32_t randart_seed, bool create_file)
 	Rand_value = randart_seed;
 	Rand_quick = true;
 
-	/* Open the log file for writing */
-	path_build(fname, sizeof(fname), ANGBAND_DIR_USER, "randart.log");
-	log_file = file_open(fname, MODE_WRITE, FTYPE_TEXT);
-	if (!log_file) {
-		msg("Error - can't open randart.log for writing.");
-		artifact_set_data_free(standarts);
-		exit(1);
-	}
-
 	/* Store the original power ratings */
 	store_base_power(standarts);
 
@@ -3184,12 +3296,46 @@ void do_randart(uint32_t randart_seed, bool create_file)
 	randarts = artifact_set_data_new();
 	store_base_power(randarts);
 	parse_frequencies(randarts);
-	artifact_set_data_free(randarts);
+
+	/* When done, resume use of the Angband "complex" RNG. */
+	Rand_quick = false;
+
+	return randarts;
+}
+
+/**
+ * Randomize the artifacts
+ *
+ * \param randart_seed is the seed for the generation.
+ * \param create_file is whether to write the set to randart.txt.
+ * \param create_log is whether to write the details of the generation to
+ * randart.log; without it, artifact power is evaluated by the quicker,
+ * silent path.  The set generated is the same either way.
+ */
+void do_randart(uint32_t randart_seed, bool create_file, bool create_log)
+{
+	char fname[1024];
+
+	/* Open the log file for writing */
+	if (create_log) {
+		path_build(fname, sizeof(fname), ANGBAND_DIR_USER, "randart.log");
+		log_file = file_open(fname, MODE_WRITE, FTYPE_TEXT);
+		if (!log_file) {
+			msg("Error - can't open randart.log for writing.");
+			exit(1);
+		}
+	}
+
+	/* Generate the set */
+	artifact_set_data_free(randart_set_statistics(randart_seed));
 
 	/* Close the log file */
-	if (!file_close(log_file)) {
-		msg("Error - can't close randart.log file.");
-		exit(1);
+	if (log_file) {
+		if (!file_close(log_file)) {
+			msg("Error - can't close randart.log file.");
+			exit(1);
+		}
+		log_file = NULL;
 	}
 
 	/* Write a data file if required */
@@ -3212,8 +3358,6 @@ void do_randart(uint32_t randart_seed, bool create_file)
 		if (!file_close(log_file)) {
 			quit_fmt("Error - can't close %s.", fname);
 		}
+		log_file = NULL;
 	}
-
-	/* When done, resume use of the Angband "complex" RNG. */
-	Rand_quick = false;
 }
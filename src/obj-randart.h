@@ -105,7 +105,10 @@ struct artifact_set_data {
 };
 
 
+struct artifact_set_data *artifact_set_data_new(void);
+void artifact_set_data_free(struct artifact_set_data *data);
 char *artifact_gen_name(struct artifact *a, const char ***wordlist);
-void do_randart(uint32_t randart_seed, bool create_file);
+struct artifact_set_data *randart_set_statistics(uint32_t randart_seed);
+void do_randart(uint32_t randart_seed, bool create_file, bool create_log);
 
 #endif /* OBJECT_RANDART_H */
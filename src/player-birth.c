@@ -1283,7 +1283,7 @@ void do_cmd_accept_character(struct command *cmd)
 	/* Now only randomize the artifacts if required */
 	if (OPT(player, birth_randarts)) {
 		seed_randart = randint0(0x10000000);
-		do_randart(seed_randart, true);
+		do_randart(seed_randart, true, true);
 		deactivate_randart_file();
 	}
 
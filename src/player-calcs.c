@@ -1690,18 +1690,11 @@ int calc_unlocking_chance(const struct player *p, int lock_power,
 }
 
 /**
- * Calculate the blows a player would get.
- *
- * \param p is the player of interest
- * \param obj is the object for which we are calculating blows
- * \param state is the player state for which we are calculating blows
- * \param extra_blows is the number of +blows available from this object and
- * this state
- *
- * N.B. state->num_blows is now 100x the number of blows.
+ * Calculate the blows a player would get with the given strength and
+ * dexterity indices.
  */
-int calc_blows(struct player *p, const struct object *obj,
-			   struct player_state *state, int extra_blows)
+static int blows_for_stat_ind(struct player *p, const struct object *obj,
+		int str_ind, int dex_ind, int extra_blows)
 {
 	int blows;
 	int str_index, dex_index;
@@ -1715,14 +1708,13 @@ int calc_blows(struct player *p, const struct object *obj,
 	div = (weight < min_weight) ? min_weight : weight;
 
 	/* Get the strength vs weight */
-	str_index = adj_str_blow[state->stat_ind[STAT_STR]] *
-			p->class->att_multiply / div;
+	str_index = adj_str_blow[str_ind] * p->class->att_multiply / div;
 
 	/* Maximal value */
 	if (str_index > 11) str_index = 11;
 
 	/* Index by dexterity */
-	dex_index = MIN(adj_dex_blow[state->stat_ind[STAT_DEX]], 11);
+	dex_index = MIN(adj_dex_blow[dex_ind], 11);
 
 	/* Use the blows table to get energy per blow */
 	blow_energy = blows_table[str_index][dex_index];
@@ -1734,6 +1726,74 @@ int calc_blows(struct player *p, const struct object *obj,
 			   OPT(p, birth_percent_damage) ? 200 : 100);
 }
 
+/**
+ * Calculate the blows a player would get.
+ *
+ * \param p is the player of interest
+ * \param obj is the object for which we are calculating blows
+ * \param state is the player state for which we are calculating blows
+ * \param extra_blows is the number of +blows available from this object and
+ * this state
+ *
+ * N.B. state->num_blows is now 100x the number of blows.
+ */
+int calc_blows(struct player *p, const struct object *obj,
+			   struct player_state *state, int extra_blows)
+{
+	return blows_for_stat_ind(p, obj, state->stat_ind[STAT_STR],
+		state->stat_ind[STAT_DEX], extra_blows);
+}
+
+/**
+ * Convert a modified stat value into an index into the stat tables.
+ */
+static int stat_ind_for_value(int use)
+{
+	if (use <= 3) {/* Values: n/a */
+		return 0;
+	} else if (use <= 18) {/* Values: 3, 4, ..., 18 */
+		return (use - 3);
+	} else if (use <= 18+219) {/* Ranges: 18/00-18/09, ..., 18/210-18/219 */
+		return (15 + (use - 18) / 10);
+	}
+
+	/* Range: 18/220+ */
+	return (37);
+}
+
+/**
+ * Calculate the blows a player would get with a weapon if their strength and
+ * dexterity indices were raised, without redoing calc_bonuses().
+ *
+ * \param p is the player of interest
+ * \param weapon is the wielded weapon, or NULL for unarmed
+ * \param state is the result of calc_bonuses() with that weapon wielded and
+ * update set to false
+ * \param str_plus is the amount to add to the strength index
+ * \param dex_plus is the amount to add to the dexterity index
+ *
+ * Gives the same num_blows as calling calc_bonuses() with update set to false
+ * and str_plus and dex_plus as the strength and dexterity indices in the
+ * state passed in.
+ */
+int calc_blows_with_stat_plus(struct player *p, const struct object *weapon,
+		const struct player_state *state, int str_plus, int dex_plus)
+{
+	int str_ind = stat_ind_for_value(state->stat_use[STAT_STR]) + str_plus;
+	int dex_ind = stat_ind_for_value(state->stat_use[STAT_DEX]) + dex_plus;
+
+	str_ind = MAX(MIN(str_ind, 37), 3);
+	dex_ind = MAX(MIN(dex_ind, 37), 3);
+
+	/* Too heavy to wield well means the default single blow */
+	if (weapon && adj_str_hold[str_ind] < object_weight_one(weapon) / 10) {
+		return 100;
+	}
+
+	return blows_for_stat_ind(p, weapon, str_ind, dex_ind,
+		state->extra_blows);
+}
+
 
 /**
  * Computes current weight limit.
@@ -1852,6 +1912,176 @@ static void calc_shapechange(struct player_state *state, bool vuln[ELEM_MAX],
 	}
 }
 
+/**
+ * What one equipment slot, with its object and any curses on that, adds to
+ * the player's state.  Everything here is summed, unioned or maximised over
+ * the slots by calc_bonuses(), so the slots can be worked out independently.
+ */
+struct slot_bonus {
+	bool valid;				/**< Filled in by a full calc_bonuses() */
+	const struct object *obj;	/**< Object in the slot when filled in */
+	bitflag flags[OF_SIZE];
+	int stat_add[STAT_MAX];
+	int skills[SKILL_MAX];
+	int see_infra;
+	int speed;
+	int dam_red;
+	int extra_blows;
+	int extra_shots;
+	int extra_might;
+	int extra_moves;
+	int res_level[ELEM_MAX];	/**< Best resist, not counting vulnerability */
+	bool vuln[ELEM_MAX];
+	int ac;
+	int to_a;
+	int to_h;
+	int to_d;
+};
+
+/**
+ * Work out the bonus for one equipment slot holding obj (possibly NULL).
+ */
+static void calc_slot_bonus(struct player *p, int slot, struct object *obj,
+		bool known_only, struct slot_bonus *b)
+{
+	int index = 0, j;
+	struct curse_data *curse = obj ? obj->curses : NULL;
+	bitflag f[OF_SIZE];
+
+	memset(b, 0, sizeof(*b));
+	b->valid = true;
+	b->obj = obj;
+
+	while (obj) {
+		int dig = 0;
+
+		/* Extract the item flags */
+		if (known_only) {
+			object_flags_known(obj, f);
+		} else {
+			object_flags(obj, f);
+		}
+		of_union(b->flags, f);
+
+		/* Apply modifiers */
+		b->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
+			* p->obj_k->modifiers[OBJ_MOD_STR];
+		b->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
+			* p->obj_k->modifiers[OBJ_MOD_INT];
+		b->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
+			* p->obj_k->modifiers[OBJ_MOD_WIS];
+		b->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
+			* p->obj_k->modifiers[OBJ_MOD_DEX];
+		b->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
+			* p->obj_k->modifiers[OBJ_MOD_CON];
+		b->skills[SKILL_STEALTH] += obj->modifiers[OBJ_MOD_STEALTH]
+			* p->obj_k->modifiers[OBJ_MOD_STEALTH];
+		b->skills[SKILL_SEARCH] += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
+			* p->obj_k->modifiers[OBJ_MOD_SEARCH];
+
+		b->see_infra += obj->modifiers[OBJ_MOD_INFRA]
+			* p->obj_k->modifiers[OBJ_MOD_INFRA];
+		if (tval_is_digger(obj)) {
+			if (of_has(obj->flags, OF_DIG_1))
+				dig = 1;
+			else if (of_has(obj->flags, OF_DIG_2))
+				dig = 2;
+			else if (of_has(obj->flags, OF_DIG_3))
+				dig = 3;
+		}
+		dig += obj->modifiers[OBJ_MOD_TUNNEL]
+			* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
+		b->skills[SKILL_DIGGING] += (dig * 20);
+		b->speed += obj->modifiers[OBJ_MOD_SPEED]
+			* p->obj_k->modifiers[OBJ_MOD_SPEED];
+		b->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
+			* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
+		b->extra_blows += obj->modifiers[OBJ_MOD_BLOWS]
+			* p->obj_k->modifiers[OBJ_MOD_BLOWS];
+		b->extra_shots += obj->modifiers[OBJ_MOD_SHOTS]
+			* p->obj_k->modifiers[OBJ_MOD_SHOTS];
+		b->extra_might += obj->modifiers[OBJ_MOD_MIGHT]
+			* p->obj_k->modifiers[OBJ_MOD_MIGHT];
+		b->extra_moves += obj->modifiers[OBJ_MOD_MOVES]
+			* p->obj_k->modifiers[OBJ_MOD_MOVES];
+
+		/* Apply element info, noting vulnerabilites for later processing */
+		for (j = 0; j < ELEM_MAX; j++) {
+			if (!known_only || obj->known->el_info[j].res_level) {
+				if (obj->el_info[j].res_level == -1)
+					b->vuln[j] = true;
+
+				/* OK because res_level hasn't included vulnerability yet */
+				if (obj->el_info[j].res_level > b->res_level[j])
+					b->res_level[j] = obj->el_info[j].res_level;
+			}
+		}
+
+		/* Apply combat bonuses */
+		b->ac += obj->ac;
+		if (!known_only || obj->known->to_a)
+			b->to_a += obj->to_a;
+		if (!slot_type_is(p, slot, EQUIP_WEAPON)
+				&& !slot_type_is(p, slot, EQUIP_BOW)) {
+			if (!known_only || obj->known->to_h) {
+				b->to_h += obj->to_h;
+			}
+			if (!known_only || obj->known->to_d) {
+				b->to_d += obj->to_d;
+			}
+		}
+
+		/* Move to any unprocessed curse object */
+		if (curse) {
+			index++;
+			obj = NULL;
+			while (index < z_info->curse_max) {
+				if (curse[index].power) {
+					obj = curses[index].obj;
+					break;
+				} else {
+					index++;
+				}
+			}
+		} else {
+			obj = NULL;
+		}
+	}
+}
+
+/**
+ * Get the per-slot bonus cache to use for a call to calc_bonuses(), or NULL
+ * if it can't be trusted.
+ *
+ * A full calculation (update set) refills the cache from the equipment.  A
+ * hypothetical one (update not set) reuses the cached bonus for any slot still
+ * holding the same object, so swapping one item in only recomputes its slot;
+ * that is only safe while no recalculation is pending, since anything that
+ * changes equipment in place asks for one with PU_BONUS.
+ */
+static struct slot_bonus *slot_bonus_cache(struct player *p, bool known_only,
+		bool update)
+{
+	if (!p->upkeep->slot_bonuses) {
+		if (!update) return NULL;
+		p->upkeep->slot_bonuses = mem_zalloc(2 * z_info->equip_slots_max
+			* sizeof(struct slot_bonus));
+	}
+	if (update) {
+		int i;
+
+		/* Force everything to be worked out afresh */
+		for (i = 0; i < p->body.count; i++) {
+			p->upkeep->slot_bonuses[(known_only ? z_info->equip_slots_max
+				: 0) + i].valid = false;
+		}
+	} else if (p->upkeep->update & PU_BONUS) {
+		return NULL;
+	}
+	return p->upkeep->slot_bonuses + (known_only ? z_info->equip_slots_max
+		: 0);
+}
+
 /**
  * Calculate the players current "state", taking into account
  * not only race/class intrinsics, but also objects being worn
@@ -1884,7 +2114,7 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	int extra_moves = 0;
 	struct object *launcher = equipped_item_by_slot_name(p, "shooting");
 	struct object *weapon = equipped_item_by_slot_name(p, "weapon");
-	bitflag f[OF_SIZE];
+	struct slot_bonus *cache;
 	bitflag collect_f[OF_SIZE];
 	bool vuln[ELEM_MAX];
 
@@ -1922,106 +2152,45 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	player_flags(p, collect_f);
 
 	/* Analyze equipment */
+	cache = slot_bonus_cache(p, known_only, update);
 	for (i = 0; i < p->body.count; i++) {
-		int index = 0;
 		struct object *obj = slot_object(p, i);
-		struct curse_data *curse = obj ? obj->curses : NULL;
+		struct slot_bonus local, *b = &local;
 
-		while (obj) {
-			int dig = 0;
-
-			/* Extract the item flags */
-			if (known_only) {
-				object_flags_known(obj, f);
-			} else {
-				object_flags(obj, f);
-			}
-			of_union(collect_f, f);
-
-			/* Apply modifiers */
-			state->stat_add[STAT_STR] += obj->modifiers[OBJ_MOD_STR]
-				* p->obj_k->modifiers[OBJ_MOD_STR];
-			state->stat_add[STAT_INT] += obj->modifiers[OBJ_MOD_INT]
-				* p->obj_k->modifiers[OBJ_MOD_INT];
-			state->stat_add[STAT_WIS] += obj->modifiers[OBJ_MOD_WIS]
-				* p->obj_k->modifiers[OBJ_MOD_WIS];
-			state->stat_add[STAT_DEX] += obj->modifiers[OBJ_MOD_DEX]
-				* p->obj_k->modifiers[OBJ_MOD_DEX];
-			state->stat_add[STAT_CON] += obj->modifiers[OBJ_MOD_CON]
-				* p->obj_k->modifiers[OBJ_MOD_CON];
-			state->skills[SKILL_STEALTH] += obj->modifiers[OBJ_MOD_STEALTH]
-				* p->obj_k->modifiers[OBJ_MOD_STEALTH];
-			state->skills[SKILL_SEARCH] += (obj->modifiers[OBJ_MOD_SEARCH] * 5)
-				* p->obj_k->modifiers[OBJ_MOD_SEARCH];
-
-			state->see_infra += obj->modifiers[OBJ_MOD_INFRA]
-				* p->obj_k->modifiers[OBJ_MOD_INFRA];
-			if (tval_is_digger(obj)) {
-				if (of_has(obj->flags, OF_DIG_1))
-					dig = 1;
-				else if (of_has(obj->flags, OF_DIG_2))
-					dig = 2;
-				else if (of_has(obj->flags, OF_DIG_3))
-					dig = 3;
-			}
-			dig += obj->modifiers[OBJ_MOD_TUNNEL]
-				* p->obj_k->modifiers[OBJ_MOD_TUNNEL];
-			state->skills[SKILL_DIGGING] += (dig * 20);
-			state->speed += obj->modifiers[OBJ_MOD_SPEED]
-				* p->obj_k->modifiers[OBJ_MOD_SPEED];
-			state->dam_red += obj->modifiers[OBJ_MOD_DAM_RED]
-				* p->obj_k->modifiers[OBJ_MOD_DAM_RED];
-			extra_blows += obj->modifiers[OBJ_MOD_BLOWS]
-				* p->obj_k->modifiers[OBJ_MOD_BLOWS];
-			extra_shots += obj->modifiers[OBJ_MOD_SHOTS]
-				* p->obj_k->modifiers[OBJ_MOD_SHOTS];
-			extra_might += obj->modifiers[OBJ_MOD_MIGHT]
-				* p->obj_k->modifiers[OBJ_MOD_MIGHT];
-			extra_moves += obj->modifiers[OBJ_MOD_MOVES]
-				* p->obj_k->modifiers[OBJ_MOD_MOVES];
-
-			/* Apply element info, noting vulnerabilites for later processing */
-			for (j = 0; j < ELEM_MAX; j++) {
-				if (!known_only || obj->known->el_info[j].res_level) {
-					if (obj->el_info[j].res_level == -1)
-						vuln[j] = true;
-
-					/* OK because res_level hasn't included vulnerability yet */
-					if (obj->el_info[j].res_level > state->el_info[j].res_level)
-						state->el_info[j].res_level = obj->el_info[j].res_level;
-				}
-			}
-
-			/* Apply combat bonuses */
-			state->ac += obj->ac;
-			if (!known_only || obj->known->to_a)
-				state->to_a += obj->to_a;
-			if (!slot_type_is(p, i, EQUIP_WEAPON)
-					&& !slot_type_is(p, i, EQUIP_BOW)) {
-				if (!known_only || obj->known->to_h) {
-					state->to_h += obj->to_h;
-				}
-				if (!known_only || obj->known->to_d) {
-					state->to_d += obj->to_d;
-				}
+		if (cache && cache[i].valid && cache[i].obj == obj) {
+			b = &cache[i];
+		} else {
+			calc_slot_bonus(p, i, obj, known_only, b);
+			if (cache && update) {
+				cache[i] = local;
 			}
+		}
+		if (!obj) continue;
 
-			/* Move to any unprocessed curse object */
-			if (curse) {
-				index++;
-				obj = NULL;
-				while (index < z_info->curse_max) {
-					if (curse[index].power) {
-						obj = curses[index].obj;
-						break;
-					} else {
-						index++;
-					}
-				}
-			} else {
-				obj = NULL;
-			}
+		of_union(collect_f, b->flags);
+		for (j = 0; j < STAT_MAX; j++) {
+			state->stat_add[j] += b->stat_add[j];
+		}
+		for (j = 0; j < SKILL_MAX; j++) {
+			state->skills[j] += b->skills[j];
 		}
+		state->see_infra += b->see_infra;
+		state->speed += b->speed;
+		state->dam_red += b->dam_red;
+		extra_blows += b->extra_blows;
+		extra_shots += b->extra_shots;
+		extra_might += b->extra_might;
+		extra_moves += b->extra_moves;
+		for (j = 0; j < ELEM_MAX; j++) {
+			if (b->vuln[j])
+				vuln[j] = true;
+			if (b->res_level[j] > state->el_info[j].res_level)
+				state->el_info[j].res_level = b->res_level[j];
+		}
+		state->ac += b->ac;
+		state->to_a += b->to_a;
+		state->to_h += b->to_h;
+		state->to_d += b->to_d;
 	}
 
 	/* Apply the collected flags */
@@ -2061,16 +2230,7 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 		use = modify_stat_value(p->stat_cur[i], add);
 
 		state->stat_use[i] = use;
-
-		if (use <= 3) {/* Values: n/a */
-			ind = 0;
-		} else if (use <= 18) {/* Values: 3, 4, ..., 18 */
-			ind = (use - 3);
-		} else if (use <= 18+219) {/* Ranges: 18/00-18/09, ..., 18/210-18/219 */
-			ind = (15 + (use - 18) / 10);
-		} else {/* Range: 18/220+ */
-			ind = (37);
-		}
+		ind = stat_ind_for_value(use);
 
 		assert((0 <= ind) && (ind < STAT_RANGE));
 
@@ -2327,6 +2487,9 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	/* Movement speed */
 	state->num_moves = extra_moves;
 
+	/* Remember the extra blows for calc_blows_with_stat_plus() */
+	state->extra_blows = extra_blows;
+
 	return;
 }
 
@@ -2695,6 +2858,8 @@ void redraw_stuff(struct player *p)
 		&& !(redraw & (PR_MESSAGE | PR_MAP)))
 		return;
 
+	if (probe_aux) (*probe_aux)(PROBE_REDRAW_STUFF, 0, false);
+
 	/* For each listed flag, send the appropriate signal to the UI */
 	for (i = 0; i < N_ELEMENTS(redraw_events); i++) {
 		const struct flag_event_trigger *hnd = &redraw_events[i];
@@ -2711,14 +2876,15 @@ void redraw_stuff(struct player *p)
 
 	p->upkeep->redraw &= ~redraw;
 
-	/* Map is not shown, subwindow updates only */
-	if (!map_is_visible()) return;
-
 	/*
 	 * Do any plotting, etc. delayed from earlier - this set of updates
-	 * is over.
+	 * is over; that's skipped if the map is not shown.
 	 */
-	event_signal(EVENT_END);
+	if (map_is_visible()) {
+		event_signal(EVENT_END);
+	}
+
+	if (probe_aux) (*probe_aux)(PROBE_REDRAW_STUFF, 0, true);
 }
 
 
@@ -113,6 +113,8 @@ int calc_unlocking_chance(const struct player *p, int lock_power,
 		bool lock_unseen);
 int calc_blows(struct player *p, const struct object *obj,
 			   struct player_state *state, int extra_blows);
+int calc_blows_with_stat_plus(struct player *p, const struct object *weapon,
+		const struct player_state *state, int str_plus, int dex_plus);
 
 void health_track(struct player_upkeep *upkeep, struct monster *mon);
 void monster_race_track(struct player_upkeep *upkeep, 
@@ -945,6 +945,16 @@ int path_nearest_unknown(struct player *p, struct loc start,
 				struct loc test_grid;
 				int turns;
 
+				/*
+				 * Skip a whole word of grids at once if none
+				 * of them are passable.
+				 */
+				if (passable && grid.x % CPLANE_BITS == 0
+						&& !p->cave->planes[CPLANE_PASSABLE][
+						cplane_word(p->cave, grid)]) {
+					grid.x += CPLANE_BITS - 1;
+					continue;
+				}
 				if (loc_eq(grid, start)
 						|| !square_isknown(p->cave,
 						grid)) {
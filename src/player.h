@@ -411,6 +411,7 @@ struct player_state {
 	int num_blows;		/**< Number of blows x100 */
 	int num_shots;		/**< Number of shots x10 */
 	int num_moves;		/**< Number of extra movement actions */
+	int extra_blows;	/**< Extra blows from equipment, shape and effects */
 
 	int ammo_mult;		/**< Ammo multiplier */
 	int ammo_tval;		/**< Ammo variety */
@@ -492,6 +493,7 @@ struct player_upkeep {
 	int step_count;			/* Pathfinding: number of steps left */
 	int16_t *steps;			/* Pathfinding: steps in reverse order */
 	struct loc path_dest;		/* Pathfinding: destination grid */
+	struct slot_bonus *slot_bonuses;	/* Per-slot bonuses, see calc_bonuses() */
 };
 
 /**
@@ -354,16 +354,10 @@ int project_path(struct chunk *c, struct loc *gp, int range, struct loc grid1,
 
 
 /**
- * Determine if a bolt spell cast from grid1 to grid2 will arrive
- * at the final destination, assuming that no monster gets in the way,
- * using the project_path() function to check the projection path.
- *
- * Note that no grid is ever projectable() from itself.
- *
- * This function is used to determine if the player can (easily) target
- * a given grid, and if a monster can target the player.
+ * Trace the projection path for projectable()
  */
-bool projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
+static bool projectable_trace(struct chunk *c, struct loc grid1,
+		struct loc grid2, int flg)
 {
 	struct loc grid_g[512];
 	int grid_n = 0;
@@ -390,6 +384,45 @@ bool projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
 	return (true);
 }
 
+/**
+ * Determine if a bolt spell cast from grid1 to grid2 will arrive
+ * at the final destination, assuming that no monster gets in the way,
+ * using the project_path() function to check the projection path.
+ *
+ * Note that no grid is ever projectable() from itself.
+ *
+ * This function is used to determine if the player can (easily) target
+ * a given grid, and if a monster can target the player.
+ *
+ * Answers about the sight memo's centre are remembered; see
+ * cave_sight_memo().
+ */
+bool projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
+{
+	uint8_t *memo = NULL;
+	uint8_t known = 0, yes = 0;
+	bool result;
+
+	/*
+	 * Bolts from the sight memo's centre, and normal range monster spells
+	 * at it, only depend on the terrain, so their answers are remembered
+	 */
+	if (flg == PROJECT_NONE) {
+		memo = cave_sight_memo(c, grid1, grid2);
+		known = SIGHT_FROM_KNOWN;
+		yes = SIGHT_FROM;
+	} else if (flg == PROJECT_SHORT && !player->timed[TMD_COVERTRACKS]) {
+		memo = cave_sight_memo(c, grid2, grid1);
+		known = SIGHT_TO_KNOWN;
+		yes = SIGHT_TO;
+	}
+
+	if (memo && (*memo & known)) return (*memo & yes) != 0;
+	result = projectable_trace(c, grid1, grid2, flg);
+	if (memo) *memo |= known | (result ? yes : 0);
+	return result;
+}
+
 
 
 
@@ -756,6 +756,9 @@ void wr_stores(void)
 		/* Save the stock size */
 		wr_byte(store->stock_num);
 
+		/* Save the maintenance still owed */
+		wr_u16b(store->maint_days);
+
 		/* Save the stock */
 		for (obj = store->stock; obj; obj = obj->next) {
 			wr_item(obj->known);
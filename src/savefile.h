@@ -96,6 +96,7 @@ int rd_misc(void);
 int rd_player_hp(void);
 int rd_player_spells(void);
 int rd_gear(void);
+int rd_stores_1(void);
 int rd_stores(void);
 int rd_dungeon(void);
 int rd_chunks(void);
@@ -0,0 +1,259 @@
+/**
+ * \file spectator-view.c
+ * \brief Reference viewer for a screen published with angband -b<name>
+ *
+ * Maps the shared memory object read-only and redraws the rows that changed
+ * on the terminal it runs in, using 24-bit colour escapes, at most a fixed
+ * number of times a second.  It stops when the game closes the object or on
+ * an interrupt.  Tiles are shown as '#' since there are no fonts here to
+ * draw them with.
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "h-basic.h"
+#include "ui-spectator.h"
+
+#include <fcntl.h>
+#include <locale.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Attempts at getting a consistent copy of a frame before waiting again */
+#define VIEW_READ_TRIES 8
+
+static volatile sig_atomic_t view_stop = 0;
+
+static void view_signal(int sig)
+{
+	(void)sig;
+	view_stop = 1;
+}
+
+/**
+ * Copy the newest frame out of the ring.  Returns false if the game kept
+ * overwriting the slot being read.
+ */
+static bool view_read(const struct spectator_header *h,
+		struct spectator_frame *out)
+{
+	int tries, y;
+
+	for (tries = 0; tries < VIEW_READ_TRIES; tries++) {
+		uint32_t frame = __atomic_load_n(&h->frame, __ATOMIC_ACQUIRE);
+		const struct spectator_frame *f =
+			&h->slots[frame % SPECTATOR_SLOTS];
+		uint32_t seq = __atomic_load_n(&f->seq, __ATOMIC_ACQUIRE);
+
+		if (seq & 1) continue;
+
+		/* Everything before the cells, then just the used rows */
+		memcpy(out, f, offsetof(struct spectator_frame, cells));
+		out->wid = MIN(out->wid, SPECTATOR_MAX_WID);
+		out->hgt = MIN(out->hgt, SPECTATOR_MAX_HGT);
+		for (y = 0; y < out->hgt; y++) {
+			memcpy(&out->cells[y * SPECTATOR_MAX_WID],
+				&f->cells[y * SPECTATOR_MAX_WID],
+				out->wid * sizeof(out->cells[0]));
+		}
+
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+		if (__atomic_load_n(&f->seq, __ATOMIC_RELAXED) == seq) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Emit the colours for attribute a if they differ from the last ones sent.
+ */
+static void view_color(const struct spectator_frame *f, int32_t a,
+		bool pict, int *last_fg, int *last_bg)
+{
+	int fg, bg;
+
+	if (pict) {
+		fg = COLOUR_WHITE;
+		bg = COLOUR_DARK;
+	} else {
+		fg = ((a % MAX_COLORS) + MAX_COLORS) % MAX_COLORS;
+		switch (a / MULT_BG) {
+			case BG_SAME: bg = fg; break;
+			case BG_DARK: bg = COLOUR_SHADE; break;
+			default: bg = COLOUR_DARK; break;
+		}
+	}
+	if (fg == *last_fg && bg == *last_bg) return;
+
+	printf("\033[38;2;%d;%d;%d;48;2;%d;%d;%dm",
+		f->colors[fg][1], f->colors[fg][2], f->colors[fg][3],
+		f->colors[bg][1], f->colors[bg][2], f->colors[bg][3]);
+	*last_fg = fg;
+	*last_bg = bg;
+}
+
+/**
+ * Redraw the rows of cur that differ from prev, or all of them if full.
+ */
+static void view_draw(const struct spectator_frame *cur,
+		const struct spectator_frame *prev, bool full)
+{
+	int x, y;
+
+	if (full) printf("\033[0m\033[2J");
+	for (y = 0; y < cur->hgt; y++) {
+		const struct spectator_cell *row =
+			&cur->cells[y * SPECTATOR_MAX_WID];
+		int last_fg = -1, last_bg = -1;
+
+		if (!full && !memcmp(row, &prev->cells[y * SPECTATOR_MAX_WID],
+				cur->wid * sizeof(*row))) {
+			continue;
+		}
+
+		printf("\033[%d;1H", y + 1);
+		for (x = 0; x < cur->wid; x++) {
+			bool pict = cur->higher_pict && (row[x].a & 0x80);
+			wchar_t c = (wchar_t)row[x].c;
+			char buf[MB_LEN_MAX];
+			mbstate_t mbs;
+			size_t n;
+
+			view_color(cur, row[x].a, pict, &last_fg, &last_bg);
+			if (pict) {
+				c = L'#';
+			} else if (!iswprint(c)) {
+				c = L' ';
+			}
+			memset(&mbs, 0, sizeof(mbs));
+			n = wcrtomb(buf, c, &mbs);
+			if (n == (size_t)-1) {
+				buf[0] = '?';
+				n = 1;
+			}
+			fwrite(buf, 1, n, stdout);
+		}
+		printf("\033[0m");
+	}
+
+	if (cur->cursor) {
+		printf("\033[%d;%dH\033[?25h", cur->cy + 1, cur->cx + 1);
+	} else {
+		printf("\033[?25l");
+	}
+	fflush(stdout);
+}
+
+static void view_usage(void)
+{
+	fprintf(stderr, "Usage: angband-spectator [-f <fps>] <name>\n"
+		"  -f <fps>  Redraw at most <fps> times a second (default 30)\n"
+		"  <name>    Shared memory name given to angband with -b\n");
+	exit(1);
+}
+
+int main(int argc, char *argv[])
+{
+	const char *name = NULL;
+	char path[256];
+	int fps = 30, fd, i;
+	struct stat st;
+	const struct spectator_header *h;
+	struct spectator_frame *cur, *prev;
+	uint32_t shown = 0;
+	bool full = true;
+	struct timespec pause;
+
+	for (i = 1; i < argc; i++) {
+		if (!strcmp(argv[i], "-f") && i + 1 < argc) {
+			fps = atoi(argv[++i]);
+			if (fps < 1) fps = 1;
+		} else if (argv[i][0] != '-' && !name) {
+			name = argv[i];
+		} else {
+			view_usage();
+		}
+	}
+	if (!name) view_usage();
+	snprintf(path, sizeof(path), "%s%s", (name[0] == '/') ? "" : "/", name);
+
+	setlocale(LC_ALL, "");
+
+	fd = shm_open(path, O_RDONLY, 0);
+	if (fd < 0) {
+		fprintf(stderr, "angband-spectator: cannot open %s: %s\n", path,
+			strerror(errno));
+		return 1;
+	}
+	if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(*h)) {
+		fprintf(stderr, "angband-spectator: %s is not a published screen\n",
+			path);
+		return 1;
+	}
+	h = mmap(NULL, sizeof(*h), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (h == MAP_FAILED || h->magic != SPECTATOR_MAGIC
+			|| h->version != SPECTATOR_VERSION) {
+		fprintf(stderr, "angband-spectator: %s is not a published screen\n",
+			path);
+		return 1;
+	}
+
+	cur = malloc(sizeof(*cur));
+	prev = malloc(sizeof(*prev));
+	if (!cur || !prev) return 1;
+	prev->wid = 0;
+	prev->hgt = 0;
+
+	signal(SIGINT, view_signal);
+	signal(SIGTERM, view_signal);
+	signal(SIGHUP, view_signal);
+
+	/* Use the alternate screen so the shell's output comes back after */
+	printf("\033[?1049h");
+	pause.tv_sec = 0;
+	pause.tv_nsec = 1000000000L / fps;
+	if (fps == 1) {
+		pause.tv_sec = 1;
+		pause.tv_nsec = 0;
+	}
+
+	while (!view_stop && !__atomic_load_n(&h->closed, __ATOMIC_ACQUIRE)) {
+		uint32_t frame = __atomic_load_n(&h->frame, __ATOMIC_ACQUIRE);
+
+		if (frame && frame != shown && view_read(h, cur)) {
+			struct spectator_frame *swap = prev;
+
+			full = full || cur->wid != prev->wid
+				|| cur->hgt != prev->hgt
+				|| memcmp(cur->colors, prev->colors,
+					sizeof(cur->colors));
+			view_draw(cur, prev, full);
+			full = false;
+			shown = cur->frame;
+			prev = cur;
+			cur = swap;
+		}
+		nanosleep(&pause, NULL);
+	}
+
+	printf("\033[0m\033[?25h\033[?1049l");
+	fflush(stdout);
+	if (!view_stop) printf("The game stopped publishing.\n");
+
+	free(prev);
+	free(cur);
+	munmap((void *)h, sizeof(*h));
+	return 0;
+}
@@ -46,6 +46,11 @@
 
 static void store_maint(struct store *s);
 
+/**
+ * Most daily maintenance passes a store will catch up on at once
+ */
+#define STORE_MAINT_DAYS_MAX 50
+
 /**
  * ------------------------------------------------------------------------
  * Constants and definitions
@@ -76,8 +81,12 @@ static const char *obj_flags[] = {
  */
 struct store *store_at(struct chunk *c, struct loc grid)
 {
-	if (square_isshop(c, grid))
-		return &stores[square_shopnum(c, grid)];
+	if (square_isshop(c, grid)) {
+		struct store *s = &stores[square_shopnum(c, grid)];
+
+		store_catch_up(s);
+		return s;
+	}
 
 	return NULL;
 }
@@ -349,6 +358,7 @@ void store_reset(void) {
 		object_pile_free(NULL, NULL, s->stock);
 		s->stock_k = NULL;
 		s->stock = NULL;
+		s->maint_days = 0;
 		if (s->feat == FEAT_HOME)
 			continue;
 		for (j = 0; j < 10; j++)
@@ -1416,24 +1426,45 @@ static void store_maint(struct store *s)
 	}
 }
 
+/**
+ * Do the maintenance a store has been owed since the last return to town.
+ *
+ * Up to STORE_MAINT_DAYS_MAX passes are made, one per day; past that, the
+ * stock has turned over so many times that more passes would only replace
+ * one fresh stock with another.
+ */
+void store_catch_up(struct store *store)
+{
+	int passes = MIN(store->maint_days, STORE_MAINT_DAYS_MAX);
+
+	store->maint_days = 0;
+	while (passes--)
+		store_maint(store);
+}
+
 /**
  * Update the stores on the return to town.
+ *
+ * The stock is left alone here; each store records how many days of
+ * maintenance it is owed and catches up when next looked at, so stores the
+ * player doesn't visit cost nothing.
  */
 void store_update(void)
 {
+	int n;
+
 	if (OPT(player, cheat_xtra)) msg("Updating Shops...");
-	while (daycount--) {
-		int n;
 
-		/* Maintain each shop (except home) */
-		for (n = 0; n < z_info->store_max; n++) {
-			/* Skip the home */
-			if (stores[n].feat == FEAT_HOME) continue;
+	/* Add the days to each shop (except home) */
+	for (n = 0; n < z_info->store_max; n++) {
+		struct store *s = &stores[n];
 
-			/* Maintain */
-			store_maint(&stores[n]);
-		}
+		if (s->feat == FEAT_HOME) continue;
+		s->maint_days = MIN(s->maint_days + daycount,
+			STORE_MAINT_DAYS_MAX);
+	}
 
+	while (daycount--) {
 		/* Sometimes, shuffle the shop-keepers */
 		if (one_in_(z_info->store_shuffle)) {
 			int *non_home_inds = mem_zalloc(z_info->store_max
@@ -64,6 +64,8 @@ struct store {
 	int turnover;
 	int normal_stock_min;
 	int normal_stock_max;
+
+	uint16_t maint_days;	/* Daily maintenance passes not yet done */
 };
 
 extern struct store *stores;
@@ -78,6 +80,7 @@ struct object *store_carry(struct store *store, struct object *obj,
 void store_reset(void);
 void store_shuffle(struct store *store);
 void store_update(void);
+void store_catch_up(struct store *store);
 int price_item(struct store *store, const struct object *obj,
 			   bool store_buying, int qty);
 
@@ -0,0 +1,184 @@
+/* cave/planes */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "init.h"
+
+int setup_tests(void **state) {
+	/* Need to initialize the terrain information. */
+	set_file_paths();
+	if (!init_angband()) {
+		*state = NULL;
+		return 1;
+	}
+
+	/* Wide enough that rows span more than one word of a bitplane */
+	*state = cave_new(7, 2 * CPLANE_BITS + 5);
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	cleanup_angband();
+	return 0;
+}
+
+static void fill_cave(struct chunk *c, int feat) {
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			square_set_feat(c, grid, feat);
+		}
+	}
+}
+
+static bool planes_match_features(struct chunk *c) {
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			int feat = square(c, grid)->feat;
+
+			if (square_ispassable(c, grid) != feat_is_passable(feat)
+					|| square_isprojectable(c, grid)
+					!= feat_is_projectable(feat)
+					|| square_isnoflow(c, grid)
+					!= feat_is_no_flow(feat)
+					|| square_isfloor(c, grid)
+					!= feat_is_floor(feat)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static int test_planes_track_features(void *state) {
+	struct chunk *c = state;
+	struct chunk *fresh = cave_new(3, 3);
+
+	/* A new chunk matches its unset features. */
+	require(planes_match_features(fresh));
+	cave_free(fresh);
+
+	fill_cave(c, FEAT_GRANITE);
+	require(planes_match_features(c));
+	fill_cave(c, FEAT_FLOOR);
+	require(planes_match_features(c));
+
+	/* Changes at the word boundaries are tracked. */
+	square_set_feat(c, loc(CPLANE_BITS - 1, 3), FEAT_GRANITE);
+	square_set_feat(c, loc(CPLANE_BITS, 3), FEAT_CLOSED);
+	square_set_feat(c, loc(c->width - 1, 3), FEAT_RUBBLE);
+	require(planes_match_features(c));
+	require(!square_ispassable(c, loc(CPLANE_BITS, 3)));
+	require(square_isnoflow(c, loc(c->width - 1, 3)));
+	require(!square_isnoflow(c, loc(CPLANE_BITS, 3)));
+	ok;
+}
+
+static int test_bits_step(void *state) {
+	struct chunk *c = state;
+	uint64_t *frontier = cave_bits_new(c);
+	uint64_t *visited = cave_bits_new(c);
+	uint64_t *next = cave_bits_new(c);
+	struct loc start = loc(CPLANE_BITS - 1, 3), grid;
+	int ymin = start.y, ymax = start.y, steps = 0;
+	bool reached_all = true;
+
+	/* Fill a floor with a wall across it, broken by one gap. */
+	fill_cave(c, FEAT_FLOOR);
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		if (grid.y != 0) {
+			square_set_feat(c, loc(CPLANE_BITS + 1, grid.y),
+				FEAT_GRANITE);
+		}
+	}
+	frontier[cplane_word(c, start)] |= cplane_bit(start);
+	visited[cplane_word(c, start)] |= cplane_bit(start);
+
+	/* One diagonal step reaches the 3x3 block around the start. */
+	require(cave_bits_step(c, frontier, c->planes[CPLANE_PASSABLE],
+		visited, next, true, &ymin, &ymax));
+	eq(ymin, start.y - 1);
+	eq(ymax, start.y + 1);
+	for (grid.y = start.y - 1; grid.y <= start.y + 1; ++grid.y) {
+		for (grid.x = start.x - 1; grid.x <= start.x + 1; ++grid.x) {
+			bool in_next = (next[cplane_word(c, grid)]
+				& cplane_bit(grid)) != 0;
+
+			require(in_next == !loc_eq(grid, start));
+		}
+	}
+
+	/* Keep going until the fill stops; it gets through the gap. */
+	do {
+		uint64_t *swap = frontier;
+
+		frontier = next;
+		next = swap;
+		++steps;
+	} while (steps < 1000 && cave_bits_step(c, frontier,
+		c->planes[CPLANE_PASSABLE], visited, next, true, &ymin,
+		&ymax));
+	require(steps < 1000);
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			bool seen = (visited[cplane_word(c, grid)]
+				& cplane_bit(grid)) != 0;
+
+			if (seen != square_ispassable(c, grid)) {
+				reached_all = false;
+			}
+		}
+	}
+	require(reached_all);
+
+	mem_free(next);
+	mem_free(visited);
+	mem_free(frontier);
+	ok;
+}
+
+static int test_sight_memo_follows_terrain(void *state) {
+	struct chunk *c = state;
+	struct loc centre = loc(2, 3), far = loc(CPLANE_BITS + 3, 3);
+	struct loc wall = loc(CPLANE_BITS, 3);
+	uint8_t *memo;
+
+	fill_cave(c, FEAT_FLOOR);
+	cave_sight_centre(c, centre);
+
+	/* Only sight lines from the centre are remembered. */
+	null(cave_sight_memo(c, far, centre));
+	memo = cave_sight_memo(c, centre, far);
+	notnull(memo);
+	eq(*memo, 0);
+	require(los(c, centre, far));
+	eq(*memo, SIGHT_LOS_KNOWN | SIGHT_LOS);
+
+	/* A new wall in the way is noticed. */
+	square_set_feat(c, wall, FEAT_GRANITE);
+	require(!los(c, centre, far));
+	memo = cave_sight_memo(c, centre, far);
+	eq(*memo, SIGHT_LOS_KNOWN);
+	square_set_feat(c, wall, FEAT_FLOOR);
+	require(los(c, centre, far));
+
+	/* Moving the centre forgets the old answers. */
+	cave_sight_centre(c, loc(3, 3));
+	null(cave_sight_memo(c, centre, far));
+	eq(*cave_sight_memo(c, loc(3, 3), far), 0);
+	ok;
+}
+
+const char *suite_name = "cave/planes";
+struct test tests[] = {
+	{ "planes track features", test_planes_track_features },
+	{ "bits step", test_bits_step },
+	{ "sight memo follows terrain", test_sight_memo_follows_terrain },
+	{ NULL, NULL }
+};
@@ -1,3 +1,4 @@
 TESTPROGS += \
 	cave/find \
+	cave/planes \
 	cave/scatter
@@ -0,0 +1,221 @@
+/* game/store.c */
+/* Check that store maintenance waits until a store is looked at. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "game-world.h"
+#include "cave.h"
+#include "init.h"
+#include "player.h"
+#include "player-birth.h"
+#include "store.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+
+	if (!player_make_simple(NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	store_reset();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+static struct store *first_store_with_turnover(void) {
+	int i;
+
+	for (i = 0; i < z_info->store_max; i++) {
+		if (stores[i].feat != FEAT_HOME && stores[i].turnover) {
+			return &stores[i];
+		}
+	}
+	return NULL;
+}
+
+static int test_update_defers(void *state) {
+	struct store *s = first_store_with_turnover();
+	struct object *stock;
+	int i, num;
+
+	notnull(s);
+	stock = s->stock;
+	num = s->stock_num;
+	daycount = 3;
+	store_update();
+	eq(daycount, 0);
+	for (i = 0; i < z_info->store_max; i++) {
+		eq(stores[i].maint_days, (stores[i].feat == FEAT_HOME) ? 0 : 3);
+	}
+
+	/* Nothing has been restocked yet. */
+	ptreq(s->stock, stock);
+	eq(s->stock_num, num);
+
+	/* A later return to town adds to what is owed. */
+	daycount = 2;
+	store_update();
+	eq(s->maint_days, 5);
+	ok;
+}
+
+static int test_catch_up(void *state) {
+	struct store *s = first_store_with_turnover();
+	int i;
+
+	notnull(s);
+	require(s->maint_days > 0);
+	store_catch_up(s);
+	eq(s->maint_days, 0);
+	require(s->stock_num >= s->normal_stock_min + (int)s->always_num);
+	require(s->stock_num <= s->normal_stock_max + (int)s->always_num);
+
+	/* Others are still waiting. */
+	for (i = 0; i < z_info->store_max; i++) {
+		if (&stores[i] == s || stores[i].feat == FEAT_HOME) continue;
+		require(stores[i].maint_days > 0);
+		store_catch_up(&stores[i]);
+		eq(stores[i].maint_days, 0);
+	}
+	ok;
+}
+
+/* Make the following rolls repeatable. */
+static void seed_rolls(uint32_t seed) {
+	Rand_quick = true;
+	Rand_value = seed;
+}
+
+/*
+ * Sum up a store's stock, along with the next random number drawn, so that
+ * two turnovers can be compared.
+ */
+static uint32_t stock_sum(const struct store *s) {
+	const struct object *obj;
+	uint32_t sum = Rand_div(0x10000);
+
+	for (obj = s->stock; obj; obj = obj->next) {
+		sum = sum * 31 + obj->kind->kidx;
+		sum = sum * 31 + obj->number;
+	}
+	return sum;
+}
+
+/*
+ * Restock every store from a fixed seed; the owners are fixed first, since
+ * the shuffle keeps rolling until the owner changes.
+ */
+static void restock_from_seed(void) {
+	int i;
+
+	for (i = 0; i < z_info->store_max; i++) {
+		stores[i].owner = store_ownerbyidx(&stores[i], 0);
+	}
+	seed_rolls(1);
+	store_reset();
+}
+
+/* Restock from a fixed seed and catch up on the given number of days. */
+static uint32_t catch_up_outcome(struct store *s, int owed) {
+	restock_from_seed();
+	seed_rolls(2);
+	s->maint_days = owed;
+	store_catch_up(s);
+	return stock_sum(s);
+}
+
+static int test_long_absence(void *state) {
+	struct store *s = first_store_with_turnover();
+	int i;
+
+	notnull(s);
+	daycount = 60000;
+	store_update();
+	for (i = 0; i < z_info->store_max; i++) {
+		eq(stores[i].maint_days, (stores[i].feat == FEAT_HOME) ? 0 : 50);
+	}
+
+	/* The count stays capped over later returns. */
+	daycount = 10;
+	store_update();
+	eq(s->maint_days, 50);
+	store_catch_up(s);
+	eq(s->maint_days, 0);
+	require(s->stock_num <= s->normal_stock_max + (int)s->always_num);
+	ok;
+}
+
+static int test_catch_up_cap(void *state) {
+	struct store *s = first_store_with_turnover();
+	uint32_t capped, outcome;
+
+	notnull(s);
+	capped = catch_up_outcome(s, 50);
+
+	/* Days past the cap make no further passes... */
+	outcome = catch_up_outcome(s, 51);
+	eq(outcome, capped);
+	outcome = catch_up_outcome(s, 60000);
+	eq(outcome, capped);
+
+	/* ...but each day up to it does. */
+	outcome = catch_up_outcome(s, 49);
+	require(outcome != capped);
+	ok;
+}
+
+static int test_turnover_order(void *state) {
+	struct store *s = first_store_with_turnover();
+	struct chunk *c = cave_new(3, 3);
+	struct loc grid = loc(1, 1);
+	struct object *stock;
+	uint32_t expected, outcome;
+	int i;
+
+	notnull(s);
+	notnull(c);
+	square_set_feat(c, grid, s->feat);
+
+	/* What the store turns over to when it catches up on 5 days. */
+	expected = catch_up_outcome(s, 5);
+
+	/* Returning to town only records the days owed. */
+	restock_from_seed();
+	stock = s->stock;
+	daycount = 5;
+	store_update();
+	eq(s->maint_days, 5);
+	ptreq(s->stock, stock);
+
+	/* Looking at the store then turns the stock over. */
+	seed_rolls(2);
+	ptreq(store_at(c, grid), s);
+	eq(s->maint_days, 0);
+
+	/* Only the store looked at has done so. */
+	for (i = 0; i < z_info->store_max; i++) {
+		if (&stores[i] == s) continue;
+		eq(stores[i].maint_days, (stores[i].feat == FEAT_HOME) ? 0 : 5);
+	}
+
+	/* The turnover matches a catch-up made with the same rolls. */
+	outcome = stock_sum(s);
+	eq(outcome, expected);
+	cave_free(c);
+	ok;
+}
+
+const char *suite_name = "game/store";
+struct test tests[] = {
+	{ "update defers", test_update_defers },
+	{ "catch up", test_catch_up },
+	{ "long absence", test_long_absence },
+	{ "catch up cap", test_catch_up_cap },
+	{ "turnover order", test_turnover_order },
+	{ NULL, NULL }
+};
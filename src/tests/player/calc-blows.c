@@ -0,0 +1,104 @@
+/* player/calc-blows.c */
+/* Check calc_blows_with_stat_plus() against calc_bonuses(). */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "init.h"
+#include "obj-gear.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-tval.h"
+#include "object.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+
+	if (!player_make_simple(NULL, "Warrior", "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Compare the blows for one weapon over a spread of stat increases.
+ */
+static bool blows_agree(struct object *obj) {
+	int weapon_slot = slot_by_name(player, "weapon");
+	struct object *current_weapon = slot_object(player, weapon_slot);
+	struct player_state base, full;
+	bool agree = true;
+	int str_plus, dex_plus;
+
+	player->body.slots[weapon_slot].obj = obj;
+	memcpy(&base, &player->state, sizeof(base));
+	base.stat_ind[STAT_STR] = 0;
+	base.stat_ind[STAT_DEX] = 0;
+	calc_bonuses(player, &base, true, false);
+	for (str_plus = 0; str_plus < STAT_RANGE && agree; str_plus += 3) {
+		for (dex_plus = 0; dex_plus < STAT_RANGE; dex_plus += 4) {
+			memcpy(&full, &player->state, sizeof(full));
+			full.stat_ind[STAT_STR] = str_plus;
+			full.stat_ind[STAT_DEX] = dex_plus;
+			calc_bonuses(player, &full, true, false);
+			if (full.num_blows != calc_blows_with_stat_plus(player,
+					obj, &base, str_plus, dex_plus)) {
+				agree = false;
+				break;
+			}
+		}
+	}
+	player->body.slots[weapon_slot].obj = current_weapon;
+	return agree;
+}
+
+static int test_matches_calc_bonuses(void *state) {
+	int k, stat, tried = 0;
+
+	/* Weak enough that heavy weapons are too heavy to wield well */
+	for (stat = 0; stat < STAT_MAX; stat++) {
+		player->stat_max[stat] = 8;
+		player->stat_cur[stat] = 8;
+	}
+	for (k = 0; k < z_info->k_max; k++) {
+		struct object_kind *kind = &k_info[k];
+		struct object *obj;
+		bool agree;
+
+		if (!kind->name || kf_has(kind->kind_flags, KF_INSTA_ART)
+				|| !(kind->tval == TV_SWORD
+				|| kind->tval == TV_HAFTED
+				|| kind->tval == TV_POLEARM)) {
+			continue;
+		}
+		obj = object_new();
+		object_prep(obj, kind, 10, AVERAGE);
+		obj->known = object_new();
+		object_copy(obj->known, obj);
+
+		/* Extra blows from the weapon carry through */
+		obj->modifiers[OBJ_MOD_BLOWS] = tried % 2;
+		obj->known->modifiers[OBJ_MOD_BLOWS] = tried % 2;
+		agree = blows_agree(obj);
+		object_delete(NULL, NULL, &obj->known);
+		object_delete(NULL, NULL, &obj);
+		require(agree);
+		++tried;
+	}
+	require(tried > 0);
+	ok;
+}
+
+const char *suite_name = "player/calc-blows";
+struct test tests[] = {
+	{ "matches calc_bonuses", test_matches_calc_bonuses },
+	{ NULL, NULL }
+};
@@ -5,6 +5,7 @@
 #include "test-utils.h"
 #include "cave.h"
 #include "effects.h"
+#include "game-input.h"
 #include "game-world.h"
 #include "generate.h"
 #include "init.h"
@@ -750,6 +751,111 @@ static int test_inven_wield_ring_two(void *state) {
 	ok;
 }
 
+static bool known_curses_match(const struct player *p,
+		const struct object *obj) {
+	int i;
+
+	for (i = 1; i < z_info->curse_max; i++) {
+		int power = (obj->curses && p->obj_k->curses[i].power) ?
+			obj->curses[i].power : 0;
+		int known = obj->known->curses ? obj->known->curses[i].power : 0;
+
+		if (power != known) return false;
+	}
+	return true;
+}
+
+static int test_inven_wield_cursed_knowledge(void *state) {
+	struct object *obj;
+	int i;
+
+	require(empty_gear(player));
+	obj = setup_object(TV_SWORD, 1, 1);
+	require(obj != NULL);
+	gear_insert_end(player, obj);
+	player->upkeep->total_weight += object_weight_one(obj);
+	inven_wield(obj, wield_slot(obj));
+	require(object_is_equipped(player->body, obj));
+
+	/* Know the combat bonuses and every curse, but not telepathy. */
+	player->obj_k->to_h = 1;
+	player->obj_k->to_d = 1;
+	for (i = 1; i < z_info->curse_max; i++) {
+		player->obj_k->curses[i].power = 1;
+	}
+	require(!of_has(player->obj_k->flags, OF_TELEPATHY));
+	player_know_object(player, obj);
+
+	/* Blasting the weapon shows its new bonuses and curses at once. */
+	effect_simple(EF_CURSE_WEAPON, source_player(), "0", 0, 0, 0, 0, 0,
+		NULL);
+	eq(obj->known->to_h, obj->to_h);
+	eq(obj->known->to_d, obj->to_d);
+	require(known_curses_match(player, obj));
+
+	/* Changes made behind its back show up on learning any rune. */
+	obj->to_d -= 2;
+	append_object_curse(obj, 1, 10);
+	player_learn_flag(player, OF_TELEPATHY);
+	eq(obj->known->to_d, obj->to_d);
+	require(known_curses_match(player, obj));
+	ok;
+}
+
+static struct object *uncurse_item;
+static int uncurse_index;
+
+static bool pick_uncurse_item(struct object **choice, const char *pmt,
+		const char *str, cmd_code cmd, item_tester tester, int mode) {
+	*choice = uncurse_item;
+	return true;
+}
+
+static bool pick_uncurse_index(int *choice, struct object *obj,
+		char *dice_string) {
+	*choice = uncurse_index;
+	return true;
+}
+
+static int test_inven_wield_failed_uncurse_knowledge(void *state) {
+	struct object *obj;
+	int i;
+
+	require(empty_gear(player));
+	obj = setup_object(TV_SWORD, 1, 1);
+	require(obj != NULL);
+	gear_insert_end(player, obj);
+	player->upkeep->total_weight += object_weight_one(obj);
+	inven_wield(obj, wield_slot(obj));
+	require(object_is_equipped(player->body, obj));
+
+	/* A known curse too strong to lift, and a known fragile rune. */
+	for (i = 1; i < z_info->curse_max; i++) {
+		player->obj_k->curses[i].power = 1;
+	}
+	for (i = 1; i < z_info->curse_max; i++) {
+		if (append_object_curse(obj, i, 50)) break;
+	}
+	require(i < z_info->curse_max);
+	player_learn_flag(player, OF_FRAGILE);
+	require(of_has(player->obj_k->flags, OF_FRAGILE));
+	player_know_object(player, obj);
+	require(!of_has(obj->flags, OF_FRAGILE));
+
+	/* Failing to lift it makes the weapon fragile, and shows that. */
+	uncurse_item = obj;
+	uncurse_index = i;
+	get_item_hook = pick_uncurse_item;
+	get_curse_hook = pick_uncurse_index;
+	effect_simple(EF_REMOVE_CURSE, source_player(), "1", 0, 0, 0, 0, 0,
+		NULL);
+	get_item_hook = NULL;
+	get_curse_hook = NULL;
+	require(of_has(obj->flags, OF_FRAGILE));
+	require(of_has(obj->known->flags, OF_FRAGILE));
+	ok;
+}
+
 const char *suite_name = "player/inven-wield";
 struct test tests[] = {
 	{ "inven_wield pack/single/empty slot", test_inven_wield_pack_single_empty },
@@ -766,5 +872,9 @@ struct test tests[] = {
 	{ "inven_wield ring none carried", test_inven_wield_ring_none },
 	{ "inven_wield ring one carried", test_inven_wield_ring_one },
 	{ "inven_wield ring two carried", test_inven_wield_ring_two },
+	{ "inven_wield cursed weapon knowledge",
+		test_inven_wield_cursed_knowledge },
+	{ "inven_wield failed uncurse knowledge",
+		test_inven_wield_failed_uncurse_knowledge },
 	{ NULL, NULL }
 };
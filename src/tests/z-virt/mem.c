@@ -25,9 +25,54 @@ static int test_realloc(void *state) {
 	return 0;
 }
 
+#ifdef MEM_ACCOUNTING
+static int test_accounting(void *state) {
+	struct mem_tag_stats before, during, after;
+	char *p1, *p2;
+
+	/* This file isn't in any subsystem, so it is charged to "other". */
+	mem_get_stats(MEM_TAG_OTHER, &before);
+	p1 = mem_alloc(24);
+	p2 = mem_zalloc(1000);
+	mem_get_stats(MEM_TAG_OTHER, &during);
+	eq(during.bytes, before.bytes + 1024);
+	eq(during.blocks, before.blocks + 2);
+	eq(during.allocs, before.allocs + 2);
+	require(during.peak_bytes >= during.bytes);
+	eq(p2[999], 0);
+
+	/* Growing keeps the contents and the charge follows the size. */
+	memset(p1, 0x5, 24);
+	p1 = mem_realloc(p1, 600);
+	eq(p1[23], 0x5);
+	p2 = mem_realloc(p2, 8);
+	mem_get_stats(MEM_TAG_OTHER, &after);
+	eq(after.bytes, before.bytes + 608);
+	eq(after.blocks, before.blocks + 2);
+
+	mem_free(p1);
+	mem_free(p2);
+	mem_get_stats(MEM_TAG_OTHER, &after);
+	eq(after.bytes, before.bytes);
+	eq(after.blocks, before.blocks);
+	require(after.peak_bytes >= before.bytes + 1024);
+
+	/* Strings are charged to their own subsystem. */
+	mem_get_stats(MEM_TAG_STRING, &before);
+	p1 = string_make("accounted");
+	mem_get_stats(MEM_TAG_STRING, &during);
+	eq(during.bytes, before.bytes + 10);
+	string_free(p1);
+	ok;
+}
+#endif
+
 const char *suite_name = "z-virt/mem";
 struct test tests[] = {
 	{ "alloc", test_alloc },
 	{ "realloc", test_realloc },
+#ifdef MEM_ACCOUNTING
+	{ "accounting", test_accounting },
+#endif
 	{ NULL, NULL }
 };
@@ -646,6 +646,7 @@ bool square_set_trap_timeout(struct chunk *c, struct loc grid, bool domsg,
 
 		/* Set the timer */
 		current_trap->timeout = time;
+		if (time > 0) c->timed_traps++;
 		disabled = true;
 
 		/* Message if requested */
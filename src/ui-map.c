@@ -714,6 +714,8 @@ void prt_map(void)
 	int ty, tx;
 	int clipy;
 
+	if (probe_aux) (*probe_aux)(PROBE_PRT_MAP, 0, false);
+
 	/* Redraw map sub-windows */
 	prt_map_aux();
 
@@ -741,6 +743,8 @@ void prt_map(void)
 				Term_big_queue_char(Term, vx, vy, clipy, a, c,
 					COLOUR_WHITE, L' ');
 		}
+
+	if (probe_aux) (*probe_aux)(PROBE_PRT_MAP, 0, true);
 }
 
 /**
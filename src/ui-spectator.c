@@ -0,0 +1,147 @@
+/**
+ * \file ui-spectator.c
+ * \brief Publish the main term through shared memory for spectators
+ *
+ * After each Term_fresh() of the main term, the whole screen is copied into
+ * the next slot of a ring in a POSIX shared memory object.  The copy is the
+ * same size however many viewers have the object mapped, and the game never
+ * waits for them; see ui-spectator.h for the layout and the locking rules.
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+#include "ui-spectator.h"
+#include "ui-term.h"
+
+#ifdef USE_SPECTATOR
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * The mapped object, or NULL if not publishing
+ */
+static struct spectator_header *spectator_map = NULL;
+
+/**
+ * Name of the mapped object, for removing it when done
+ */
+static char *spectator_name = NULL;
+
+/**
+ * Copy the main term into the next slot; installed as term_fresh_hook
+ */
+static void spectator_publish(term *t)
+{
+	struct spectator_header *h = spectator_map;
+	struct spectator_frame *f;
+	uint32_t frame, seq;
+	int wid, hgt, x, y;
+
+	if (!h || t != term_screen) return;
+
+	/* Frame 0 means "nothing yet", so skip it when the counter wraps */
+	frame = h->frame + 1;
+	if (!frame) frame = 1;
+	f = &h->slots[frame % SPECTATOR_SLOTS];
+
+	/* Mark the slot as being written */
+	seq = f->seq;
+	__atomic_store_n(&f->seq, seq + 1, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	wid = MIN(t->wid, SPECTATOR_MAX_WID);
+	hgt = MIN(t->hgt, SPECTATOR_MAX_HGT);
+	f->frame = frame;
+	f->wid = wid;
+	f->hgt = hgt;
+	f->cx = t->scr->cx;
+	f->cy = t->scr->cy;
+	f->cursor = t->scr->cv && !t->scr->cu;
+	f->higher_pict = t->higher_pict;
+	memcpy(f->colors, angband_color_table, sizeof(f->colors));
+	for (y = 0; y < hgt; y++) {
+		struct spectator_cell *cell = &f->cells[y * SPECTATOR_MAX_WID];
+		const int *a = t->scr->a[y];
+		const wchar_t *c = t->scr->c[y];
+
+		for (x = 0; x < wid; x++) {
+			cell[x].a = a[x];
+			cell[x].c = (uint32_t)c[x];
+		}
+	}
+
+	/* The slot is complete; point readers at it */
+	__atomic_store_n(&f->seq, seq + 2, __ATOMIC_RELEASE);
+	__atomic_store_n(&h->frame, frame, __ATOMIC_RELEASE);
+}
+
+/**
+ * Start publishing the main term under the given shared memory name.
+ *
+ * A leading '/' is added to the name if missing.  Any existing object with
+ * that name, such as one left behind by a crash, is replaced.  Returns false
+ * if the object could not be created.
+ */
+bool spectator_open(const char *name)
+{
+	char path[256];
+	struct spectator_header *h;
+	int fd;
+
+	if (spectator_map || !name[0]) return false;
+	strnfmt(path, sizeof(path), "%s%s", (name[0] == '/') ? "" : "/", name);
+
+	(void)shm_unlink(path);
+	fd = shm_open(path, O_RDWR | O_CREAT | O_EXCL, 0644);
+	if (fd < 0) return false;
+	if (ftruncate(fd, sizeof(*h)) != 0) {
+		close(fd);
+		(void)shm_unlink(path);
+		return false;
+	}
+	h = mmap(NULL, sizeof(*h), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	close(fd);
+	if (h == MAP_FAILED) {
+		(void)shm_unlink(path);
+		return false;
+	}
+
+	/* The object starts zeroed, so only the identification is needed */
+	h->magic = SPECTATOR_MAGIC;
+	h->version = SPECTATOR_VERSION;
+
+	spectator_map = h;
+	spectator_name = string_make(path);
+	term_fresh_hook = spectator_publish;
+	return true;
+}
+
+/**
+ * Stop publishing; viewers still attached see the object marked closed.
+ */
+void spectator_close(void)
+{
+	if (!spectator_map) return;
+
+	if (term_fresh_hook == spectator_publish) term_fresh_hook = NULL;
+	__atomic_store_n(&spectator_map->closed, 1, __ATOMIC_RELEASE);
+	munmap(spectator_map, sizeof(*spectator_map));
+	(void)shm_unlink(spectator_name);
+	string_free(spectator_name);
+	spectator_map = NULL;
+	spectator_name = NULL;
+}
+
+#endif /* USE_SPECTATOR */
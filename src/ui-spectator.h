@@ -0,0 +1,70 @@
+/**
+ * \file ui-spectator.h
+ * \brief Publish the main term through shared memory for spectators
+ *
+ * The game writes the main term into a POSIX shared memory object after
+ * each refresh; any number of read-only viewers can map the object and draw
+ * it at their own rate without the game knowing they are there.
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+#ifndef INCLUDED_UI_SPECTATOR_H
+#define INCLUDED_UI_SPECTATOR_H
+
+#include "h-basic.h"
+#include "z-color.h"
+
+/**
+ * Layout of the shared memory object.
+ *
+ * The game owns the object and is the only writer.  It keeps a small ring
+ * of complete frames; each slot is guarded by a sequence lock, so writing a
+ * frame never waits on readers and readers never block the game.  A reader
+ * loads `frame` from the header, copies slot (frame % SPECTATOR_SLOTS) and
+ * keeps the copy only if the slot's `seq` was even and unchanged across the
+ * copy.  Cells beyond SPECTATOR_MAX_WID or SPECTATOR_MAX_HGT are not
+ * published.
+ */
+#define SPECTATOR_MAGIC 0x53504543
+#define SPECTATOR_VERSION 1
+#define SPECTATOR_SLOTS 4
+#define SPECTATOR_MAX_WID 256
+#define SPECTATOR_MAX_HGT 96
+
+struct spectator_cell {
+	int32_t a;		/* Attribute, as in term_win */
+	uint32_t c;		/* Character, as a code point */
+};
+
+struct spectator_frame {
+	uint32_t seq;		/* Odd while the game is writing the slot */
+	uint32_t frame;		/* Frame number held in the slot */
+	uint16_t wid, hgt;	/* Size of the published part of the term */
+	uint16_t cx, cy;	/* Cursor position */
+	uint8_t cursor;		/* Is the cursor visible? */
+	uint8_t higher_pict;	/* Do attributes with 0x80 set mean a tile? */
+	uint8_t colors[MAX_COLORS][4];	/* Copy of angband_color_table */
+	struct spectator_cell cells[SPECTATOR_MAX_HGT * SPECTATOR_MAX_WID];
+};
+
+struct spectator_header {
+	uint32_t magic;
+	uint32_t version;
+	uint32_t frame;		/* Last complete frame, 0 before the first */
+	uint32_t closed;	/* Set when the game stops publishing */
+	struct spectator_frame slots[SPECTATOR_SLOTS];
+};
+
+bool spectator_open(const char *name);
+void spectator_close(void);
+
+#endif /* INCLUDED_UI_SPECTATOR_H */
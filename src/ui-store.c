@@ -1221,6 +1221,7 @@ void textui_store_knowledge(int n)
 	screen_save();
 	clear_from(0);
 
+	store_catch_up(&stores[n]);
 	store_menu_init(&ctx, &stores[n], true);
 	menu_select(&ctx.menu, 0, false);
 
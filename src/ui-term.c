@@ -310,6 +310,11 @@ int col_map[SIDEBAR_MAX] = {13, 0, 0};
  */
 term *Term = NULL;
 
+/**
+ * Called with the term after each Term_fresh() that changed something
+ */
+void (*term_fresh_hook)(term *t) = NULL;
+
 /* grumbles */
 int log_i = 0;
 int log_size = 0;
@@ -1708,7 +1713,7 @@ bool smlcurs = true;
  * Currently, the use of "Term->icky_corner" and "Term->soft_cursor"
  * together may result in undefined behavior.
  */
-errr Term_fresh(void)
+static errr Term_fresh_aux(void)
 {
 	int x, y;
 
@@ -1983,6 +1988,22 @@ errr Term_fresh(void)
 	return (0);
 }
 
+/**
+ * Actually perform all requested changes to the window; see
+ * Term_fresh_aux() for the details
+ */
+errr Term_fresh(void)
+{
+	errr result;
+
+	if (probe_aux) (*probe_aux)(PROBE_TERM_FRESH, 0, false);
+	result = Term_fresh_aux();
+	if (!result && term_fresh_hook) (*term_fresh_hook)(Term);
+	if (probe_aux) (*probe_aux)(PROBE_TERM_FRESH, 0, true);
+
+	return result;
+}
+
 
 
 /**
@@ -357,6 +357,11 @@ extern uint32_t window_flag[ANGBAND_TERM_MAX];
  * behavior of Term_inkey().
  */
 extern volatile sig_atomic_t terms_disconnecting;
+/**
+ * If set, called with the term after each Term_fresh() that changed
+ * something.
+ */
+extern void (*term_fresh_hook)(term *t);
 
 /**
  * The main "screen"
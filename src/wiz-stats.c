@@ -1558,7 +1558,7 @@ static void clearing_stats(void)
 			}
 
 			/* regen randarts */
-			do_randart(seed_randart, false);
+			do_randart(seed_randart, false, false);
 		}
 
 		/* Do game iterations */
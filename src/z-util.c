@@ -906,6 +906,11 @@ void plog(const char *str)
 
 
 
+/**
+ * Optional timing hook; see enum probe_point
+ */
+void (*probe_aux)(enum probe_point point, int detail, bool leaving) = NULL;
+
 /**
  * Redefinable "quit" action
  */
@@ -49,6 +49,21 @@ extern size_t (*text_wcslen_hook)(const wchar_t *s);
 extern void (*plog_aux)(const char *);
 extern void (*quit_aux)(const char *);
 
+/**
+ * Places reported to probe_aux, if set, on entry and on exit; the benchmark
+ * front end (main-bench.c) uses them to time the user interface
+ */
+enum probe_point {
+	PROBE_TERM_FRESH,
+	PROBE_REDRAW_STUFF,
+	PROBE_PRT_MAP,
+	/* one event handler; the detail is the event type */
+	PROBE_EVENT,
+
+	PROBE_MAX
+};
+extern void (*probe_aux)(enum probe_point point, int detail, bool leaving);
+
 
 /**
  * ------------------------------------------------------------------------
@@ -18,6 +18,372 @@
 #include "z-virt.h"
 #include "z-util.h"
 
+#ifdef MEM_ACCOUNTING
+#include "z-form.h"
+
+/**
+ * Bookkeeping kept in front of every block.  The union pads it out so that
+ * the block handed back to the caller is as well aligned as malloc()'s.
+ */
+union mem_header {
+	struct {
+		size_t len;
+		uint8_t tag;
+		uint8_t size_class;
+	} info;
+	long double align_ld;
+	long long align_ll;
+	void *align_p;
+};
+
+#define MEM_HEADER(p) ((union mem_header *)(p) - 1)
+
+/**
+ * Which subsystem a source file's allocations are charged to, by the prefix
+ * of the file's name.  The first match wins; anything else is "other".
+ */
+static const struct {
+	const char *prefix;
+	enum mem_tag tag;
+} mem_tag_prefixes[] = {
+	{ "cave", MEM_TAG_CAVE },
+	{ "gen-", MEM_TAG_CAVE },
+	{ "generate", MEM_TAG_CAVE },
+	{ "trap", MEM_TAG_CAVE },
+	{ "obj-", MEM_TAG_OBJECT },
+	{ "store", MEM_TAG_OBJECT },
+	{ "mon-", MEM_TAG_MONSTER },
+	{ "player", MEM_TAG_PLAYER },
+	{ "parser", MEM_TAG_PARSER },
+	{ "datafile", MEM_TAG_PARSER },
+	{ "init", MEM_TAG_PARSER },
+	{ "z-virt", MEM_TAG_STRING },
+	{ "z-quark", MEM_TAG_STRING },
+	{ "message", MEM_TAG_MESSAGE },
+	{ "ui-", MEM_TAG_UI },
+	{ "main", MEM_TAG_UI },
+	{ "pui-", MEM_TAG_UI },
+	{ "snd-", MEM_TAG_UI },
+	{ "borg", MEM_TAG_BORG },
+};
+
+static const char *mem_tag_names[MEM_TAG_MAX] = {
+	"other", "cave", "objects", "monsters", "player", "parser", "strings",
+	"messages", "UI", "borg"
+};
+
+/**
+ * Cache of the tags worked out for each __FILE__ pointer seen, so the name
+ * only has to be examined once per source file.
+ */
+#define MEM_TAG_CACHE_SIZE 256
+static struct {
+	const char *file;
+	uint8_t tag;
+} mem_tag_cache[MEM_TAG_CACHE_SIZE];
+
+static struct mem_tag_stats mem_stats[MEM_TAG_MAX];
+static struct mem_tag_stats mem_total;
+
+static enum mem_tag mem_tag_from_name(const char *file)
+{
+	const char *base = file;
+	const char *s;
+	size_t i;
+
+	for (s = file; *s; s++) {
+		if (*s == '/' || *s == '\\') base = s + 1;
+	}
+	for (i = 0; i < N_ELEMENTS(mem_tag_prefixes); i++) {
+		if (prefix(base, mem_tag_prefixes[i].prefix)) {
+			return mem_tag_prefixes[i].tag;
+		}
+	}
+	return MEM_TAG_OTHER;
+}
+
+static enum mem_tag mem_tag_for_file(const char *file)
+{
+	size_t h, i;
+
+	if (!file) return MEM_TAG_OTHER;
+	h = ((size_t)file >> 3) % MEM_TAG_CACHE_SIZE;
+	for (i = 0; i < MEM_TAG_CACHE_SIZE; i++) {
+		size_t j = (h + i) % MEM_TAG_CACHE_SIZE;
+
+		if (mem_tag_cache[j].file == file) {
+			return (enum mem_tag)mem_tag_cache[j].tag;
+		}
+		if (!mem_tag_cache[j].file) {
+			mem_tag_cache[j].file = file;
+			mem_tag_cache[j].tag = (uint8_t)mem_tag_from_name(file);
+			return (enum mem_tag)mem_tag_cache[j].tag;
+		}
+	}
+
+	/* Full; just work it out every time */
+	return mem_tag_from_name(file);
+}
+
+static void mem_stats_add(struct mem_tag_stats *st, size_t len)
+{
+	st->bytes += len;
+	st->blocks++;
+	st->allocs++;
+	if (st->bytes > st->peak_bytes) st->peak_bytes = st->bytes;
+}
+
+static void mem_stats_remove(struct mem_tag_stats *st, size_t len)
+{
+	st->bytes -= len;
+	st->blocks--;
+}
+
+static void mem_account_alloc(int tag, size_t len)
+{
+	mem_stats_add(&mem_stats[tag], len);
+	mem_stats_add(&mem_total, len);
+}
+
+static void mem_account_free(int tag, size_t len)
+{
+	mem_stats_remove(&mem_stats[tag], len);
+	mem_stats_remove(&mem_total, len);
+}
+
+#ifdef MEM_POOL
+/**
+ * Blocks of up to MEM_POOL_MAX bytes are carved out of slabs, one free list
+ * per MEM_POOL_GRAIN bytes of size.  Slabs are never handed back.  Size class
+ * 0 marks a block that came straight from malloc().
+ */
+#define MEM_POOL_GRAIN 16
+#define MEM_POOL_MAX 256
+#define MEM_POOL_CLASSES (MEM_POOL_MAX / MEM_POOL_GRAIN)
+#define MEM_POOL_SLAB 65536
+
+struct mem_pool_free {
+	struct mem_pool_free *next;
+};
+
+static struct mem_pool_free *mem_pool_lists[MEM_POOL_CLASSES + 1];
+
+static int mem_pool_class(size_t len)
+{
+	return (len > MEM_POOL_MAX) ? 0 :
+		(int)((len + MEM_POOL_GRAIN - 1) / MEM_POOL_GRAIN);
+}
+
+static void mem_pool_refill(int size_class)
+{
+	size_t stride = sizeof(union mem_header) + size_class * MEM_POOL_GRAIN;
+	size_t count = MEM_POOL_SLAB / stride;
+	char *slab = malloc(stride * count);
+	size_t i;
+
+	if (!slab)
+		quit("Out of memory!");
+	for (i = 0; i < count; i++) {
+		struct mem_pool_free *f = (struct mem_pool_free *)
+			(slab + i * stride + sizeof(union mem_header));
+
+		f->next = mem_pool_lists[size_class];
+		mem_pool_lists[size_class] = f;
+	}
+}
+#endif
+
+/**
+ * Get a block of at least `len` bytes with its header filled in, without
+ * touching the statistics.
+ */
+static void *mem_get_block(size_t len, int tag)
+{
+	union mem_header *h;
+	int size_class = 0;
+
+#ifdef MEM_POOL
+	size_class = mem_pool_class(len);
+	if (size_class) {
+		struct mem_pool_free *f;
+
+		if (!mem_pool_lists[size_class])
+			mem_pool_refill(size_class);
+		f = mem_pool_lists[size_class];
+		mem_pool_lists[size_class] = f->next;
+		h = MEM_HEADER(f);
+	} else
+#endif
+	{
+		h = malloc(sizeof(*h) + len);
+		if (!h)
+			quit("Out of memory!");
+	}
+	h->info.len = len;
+	h->info.tag = (uint8_t)tag;
+	h->info.size_class = (uint8_t)size_class;
+	return h + 1;
+}
+
+static void mem_put_block(void *p)
+{
+	union mem_header *h = MEM_HEADER(p);
+
+#ifdef MEM_POOL
+	if (h->info.size_class) {
+		struct mem_pool_free *f = p;
+
+		f->next = mem_pool_lists[h->info.size_class];
+		mem_pool_lists[h->info.size_class] = f;
+		return;
+	}
+#endif
+	free(h);
+}
+
+/**
+ * Allocate `len` bytes of memory, charged to the subsystem owning `file`.
+ * Behaves exactly like the unaccounted mem_alloc() otherwise.
+ */
+void *mem_alloc_from(size_t len, const char *file)
+{
+	int tag;
+
+	if (!len)
+		return NULL;
+
+	tag = mem_tag_for_file(file);
+	mem_account_alloc(tag, len);
+	return mem_get_block(len, tag);
+}
+
+void *mem_zalloc_from(size_t len, const char *file)
+{
+	void *mem = mem_alloc_from(len, file);
+	if (len)
+		memset(mem, 0, len);
+	return mem;
+}
+
+/**
+ * Resize a block.  It stays charged to the subsystem that first allocated it.
+ */
+void *mem_realloc_from(void *p, size_t len, const char *file)
+{
+	union mem_header *h;
+	size_t old_len;
+	int tag;
+	void *q;
+
+	if (!len)
+		return NULL;
+	if (!p)
+		return mem_alloc_from(len, file);
+
+	h = MEM_HEADER(p);
+	old_len = h->info.len;
+	tag = h->info.tag;
+	mem_account_free(tag, old_len);
+	mem_account_alloc(tag, len);
+
+#ifdef MEM_POOL
+	/* Stay put if the block still fits its size class */
+	if (h->info.size_class) {
+		if (mem_pool_class(len) == h->info.size_class) {
+			h->info.len = len;
+			return p;
+		}
+	} else if (!mem_pool_class(len))
+#endif
+	{
+		h = realloc(h, sizeof(*h) + len);
+		if (!h)
+			quit("Out of Memory!");
+		h->info.len = len;
+		return h + 1;
+	}
+
+	/* Moving between the pool and malloc() */
+	q = mem_get_block(len, tag);
+	memcpy(q, p, MIN(len, old_len));
+	mem_put_block(p);
+	return q;
+}
+
+void (mem_free)(void *p)
+{
+	union mem_header *h;
+
+	if (!p)
+		return;
+	h = MEM_HEADER(p);
+	mem_account_free(h->info.tag, h->info.len);
+	mem_put_block(p);
+}
+
+/**
+ * Plain entry points for anything that takes the address of the allocators
+ * or otherwise gets around the macros; these are charged to "other".
+ */
+void *(mem_alloc)(size_t len)
+{
+	return mem_alloc_from(len, NULL);
+}
+
+void *(mem_zalloc)(size_t len)
+{
+	return mem_zalloc_from(len, NULL);
+}
+
+void *(mem_realloc)(void *p, size_t len)
+{
+	return mem_realloc_from(p, len, NULL);
+}
+
+const char *mem_tag_name(int tag)
+{
+	return (tag >= 0 && tag < MEM_TAG_MAX) ? mem_tag_names[tag] : NULL;
+}
+
+void mem_get_stats(int tag, struct mem_tag_stats *stats)
+{
+	if (tag >= 0 && tag < MEM_TAG_MAX) {
+		*stats = mem_stats[tag];
+	} else {
+		memset(stats, 0, sizeof(*stats));
+	}
+}
+
+void mem_get_total_stats(struct mem_tag_stats *stats)
+{
+	*stats = mem_total;
+}
+
+/**
+ * Pass a line per subsystem, then one for the totals, to `out`.
+ */
+void mem_report(void (*out)(void *data, const char *line), void *data)
+{
+	char buf[120];
+	int i;
+
+	strnfmt(buf, sizeof(buf), "%-10s %12s %12s %10s %12s", "subsystem",
+		"bytes", "peak bytes", "blocks", "allocations");
+	out(data, buf);
+	for (i = 0; i <= MEM_TAG_MAX; i++) {
+		const struct mem_tag_stats *st = (i < MEM_TAG_MAX) ?
+			&mem_stats[i] : &mem_total;
+
+		strnfmt(buf, sizeof(buf), "%-10s %12lu %12lu %10lu %12lu",
+			(i < MEM_TAG_MAX) ? mem_tag_names[i] : "total",
+			(unsigned long)st->bytes, (unsigned long)st->peak_bytes,
+			(unsigned long)st->blocks, (unsigned long)st->allocs);
+		out(data, buf);
+	}
+}
+
+#else /* MEM_ACCOUNTING */
+
 /**
  * Allocate `len` bytes of memory.
  *
@@ -67,6 +433,8 @@ void *mem_realloc(void *p, size_t len)
 	return p;
 }
 
+#endif /* MEM_ACCOUNTING */
+
 /**
  * Duplicates an existing string `str`, allocating as much memory as necessary.
  */
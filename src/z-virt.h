@@ -42,6 +42,50 @@ bool mem_is_alt_alloc(void *p);
 #define mem_is_alt_alloc(p) (false)
 #endif
 
+/**
+ * With MEM_ACCOUNTING defined at compile time, every block handed out by
+ * mem_alloc() and friends is charged to the subsystem of the source file that
+ * asked for it, so the current use, high-water mark and allocation counts can
+ * be reported per subsystem.  Defining MEM_POOL as well serves small blocks
+ * from per-size-class free lists rather than from malloc().  Neither is
+ * thread-safe; blocks must only be allocated and freed from the game thread.
+ */
+#ifdef MEM_ACCOUNTING
+enum mem_tag {
+	MEM_TAG_OTHER = 0,
+	MEM_TAG_CAVE,
+	MEM_TAG_OBJECT,
+	MEM_TAG_MONSTER,
+	MEM_TAG_PLAYER,
+	MEM_TAG_PARSER,
+	MEM_TAG_STRING,
+	MEM_TAG_MESSAGE,
+	MEM_TAG_UI,
+	MEM_TAG_BORG,
+
+	MEM_TAG_MAX
+};
+
+struct mem_tag_stats {
+	size_t bytes;		/* Bytes currently allocated */
+	size_t peak_bytes;	/* High-water mark of bytes */
+	size_t blocks;		/* Blocks currently allocated */
+	size_t allocs;		/* Total number of allocations made */
+};
+
+void *mem_alloc_from(size_t len, const char *file);
+void *mem_zalloc_from(size_t len, const char *file);
+void *mem_realloc_from(void *p, size_t len, const char *file);
+#define mem_alloc(len) mem_alloc_from((len), __FILE__)
+#define mem_zalloc(len) mem_zalloc_from((len), __FILE__)
+#define mem_realloc(p, len) mem_realloc_from((p), (len), __FILE__)
+
+const char *mem_tag_name(int tag);
+void mem_get_stats(int tag, struct mem_tag_stats *stats);
+void mem_get_total_stats(struct mem_tag_stats *stats);
+void mem_report(void (*out)(void *data, const char *line), void *data);
+#endif
+
 char *string_make(const char *str);
 void string_free(char *str);
 char *string_append(char *s1, const char *s2);